@@ -0,0 +1,258 @@
+#include "benchmark_support.hpp"
+
+#include "positionless/algorithms.hpp"
+#include "positionless/execution.hpp"
+#include "positionless/list_algorithms.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/segments.hpp"
+#include "positionless/translation.hpp"
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <numeric>
+
+using ankerl::nanobench::doNotOptimizeAway;
+using positionless::partitioning;
+
+BENCHMARK_GROUP("algorithms/swap_first") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("swap_first of two halves", n);
+    bench::for_each_container<int>([&](auto kind) {
+      using container = typename decltype(kind)::type;
+      auto c = bench::make_container<container>(bench::make_data(n, bench::distribution::random));
+      partitioning<typename container::iterator> p(c.begin(), c.end());
+      p.add_part_begin(0);
+      p.grow_by(0, n / 2);
+      bench::run(b, kind.name, [&] {
+        positionless::swap_first(p, 0, 1);
+        doNotOptimizeAway(p);
+      });
+    });
+  }
+}
+
+BENCHMARK_GROUP("algorithms/split_runs") {
+  for (size_t n : bench::sizes(opts)) {
+    for (auto d : bench::all_distributions) {
+      auto b = bench::make_bench(std::string("split_runs, ") + bench::name(d), n);
+      bench::for_each_container<int>([&](auto kind) {
+        using container = typename decltype(kind)::type;
+        const auto c = bench::make_container<container>(bench::make_data(n, d));
+        bench::run(b, kind.name, [&] {
+          partitioning<typename container::const_iterator> p(c.begin(), c.end());
+          doNotOptimizeAway(positionless::split_runs(p, 0));
+        });
+      });
+    }
+  }
+}
+
+BENCHMARK_GROUP("algorithms/merge_with_next") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("merge_with_next of two sorted halves (includes copying input)", n);
+    auto data = bench::make_data(n, bench::distribution::random);
+    std::sort(data.begin(), data.begin() + static_cast<std::ptrdiff_t>(n / 2));
+    std::sort(data.begin() + static_cast<std::ptrdiff_t>(n / 2), data.end());
+    bench::for_each_container<int>([&](auto kind) {
+      using container = typename decltype(kind)::type;
+      using iterator = typename container::iterator;
+      if constexpr (std::bidirectional_iterator<iterator>) {
+        const auto original = bench::make_container<container>(data);
+        bench::run(b, kind.name, [&] {
+          auto c = original;
+          partitioning<iterator> p(c.begin(), c.end());
+          p.add_part_begin(0);
+          p.grow_by(0, n / 2);
+          positionless::merge_with_next(p, 0);
+          doNotOptimizeAway(c);
+        });
+        bench::run(b, std::string(kind.name) + " (std::inplace_merge)", [&] {
+          auto c = original;
+          const auto middle = std::next(c.begin(), static_cast<std::ptrdiff_t>(n / 2));
+          std::inplace_merge(c.begin(), middle, c.end());
+          doNotOptimizeAway(c);
+        });
+      }
+    });
+  }
+}
+
+BENCHMARK_GROUP("algorithms/sort_part") {
+  for (size_t n : bench::sizes(opts)) {
+    for (auto d : bench::all_distributions) {
+      auto b = bench::make_bench(
+          std::string("sort_part, ") + bench::name(d) + " (includes copying input)", n
+      );
+      bench::for_each_container<int>([&](auto kind) {
+        using container = typename decltype(kind)::type;
+        using iterator = typename container::iterator;
+        if constexpr (std::bidirectional_iterator<iterator>) {
+          const auto original = bench::make_container<container>(bench::make_data(n, d));
+          bench::run(b, kind.name, [&] {
+            auto c = original;
+            partitioning<iterator> p(c.begin(), c.end());
+            positionless::sort_part(p, 0);
+            doNotOptimizeAway(c);
+          });
+          if constexpr (std::random_access_iterator<iterator>) {
+            bench::run(b, std::string(kind.name) + " (std::stable_sort)", [&] {
+              auto c = original;
+              std::stable_sort(c.begin(), c.end());
+              doNotOptimizeAway(c);
+            });
+          } else {
+            bench::run(b, std::string(kind.name) + " (list::sort)", [&] {
+              auto c = original;
+              c.sort();
+              doNotOptimizeAway(c);
+            });
+          }
+        }
+      });
+    }
+  }
+}
+
+BENCHMARK_GROUP("algorithms/split_by") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("partitioning a part by parity", n);
+    bench::for_each_container<int>([&](auto kind) {
+      using container = typename decltype(kind)::type;
+      const auto data = bench::make_container<container>(
+          bench::make_data(n, bench::distribution::random)
+      );
+      const auto is_even = [](int x) { return x % 2 == 0; };
+      bench::run(b, std::string("std::ranges::partition, ") + kind.name, [&] {
+        auto c = data;
+        doNotOptimizeAway(std::ranges::partition(c, is_even));
+      });
+      bench::run(b, std::string("split_by(p, 0, std::ranges::partition), ") + kind.name, [&] {
+        auto c = data;
+        partitioning<typename container::iterator> p(c.begin(), c.end());
+        positionless::split_by(p, 0, std::ranges::partition, is_even);
+        doNotOptimizeAway(p);
+      });
+    });
+  }
+}
+
+BENCHMARK_GROUP("algorithms/execution_policies") {
+  for (size_t n : bench::sizes(opts)) {
+    const auto original = bench::make_data(n, bench::distribution::random);
+    auto b = bench::make_bench("random vector<int> (includes copying input)", n);
+    const auto with_policy = [&](const char* name, auto policy) {
+      bench::run(b, std::string("sort_part, ") + name, [&] {
+        auto c = original;
+        partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+        positionless::sort_part(policy, p, 0);
+        doNotOptimizeAway(c);
+      });
+      bench::run(b, std::string("split_runs, ") + name, [&] {
+        auto c = original;
+        partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+        doNotOptimizeAway(positionless::split_runs(policy, p, 0));
+      });
+    };
+    with_policy("seq", positionless::execution::seq);
+    with_policy("par", positionless::execution::par);
+  }
+}
+
+BENCHMARK_GROUP("algorithms/segments") {
+  for (size_t n : bench::sizes(opts)) {
+    const auto data = bench::make_data(n, bench::distribution::random);
+    const std::deque<int> d(data.begin(), data.end());
+    const auto is_even = [](int x) { return x % 2 == 0; };
+    auto b = bench::make_bench("deque<int>", n);
+    partitioning<std::deque<int>::const_iterator> p(d.begin(), d.end());
+    bench::run(b, "summing through iterators (std::accumulate)", [&] {
+      doNotOptimizeAway(std::accumulate(p.part(0).first, p.part(0).second, 0L));
+    });
+    bench::run(b, "summing through segments (reduce_elements)", [&] {
+      doNotOptimizeAway(positionless::reduce_elements(p, 0, 0L));
+    });
+    bench::run(b, "partitioning by parity (std::partition, includes copying input)", [&] {
+      auto c = d;
+      doNotOptimizeAway(std::partition(c.begin(), c.end(), is_even));
+    });
+    bench::run(b, "partitioning by parity (partition_part, includes copying input)", [&] {
+      auto c = d;
+      partitioning<std::deque<int>::iterator> q(c.begin(), c.end());
+      positionless::partition_part(q, 0, is_even);
+      doNotOptimizeAway(q);
+    });
+  }
+}
+
+namespace {
+
+/// An element that is expensive to move, ordered by `key`.
+struct large_element {
+  int key;
+  std::array<char, 252> payload{};
+
+  friend bool operator<(const large_element& a, const large_element& b) { return a.key < b.key; }
+};
+
+} // namespace
+
+BENCHMARK_GROUP("algorithms/list_splicing") {
+  using list = std::list<large_element>;
+  using list_partitioning = positionless::list_partitioning<list>;
+  const auto is_even = [](const large_element& x) { return x.key % 2 == 0; };
+  for (size_t n : bench::sizes(opts)) {
+    const auto data = bench::make_data(n, bench::distribution::random);
+    list original;
+    for (int x : data)
+      original.push_back({x});
+    auto b = bench::make_bench("list<256-byte element> (includes copying input)", n);
+    bench::run(b, "sort_part", [&] {
+      auto l = original;
+      list_partitioning p(l.begin(), l.end());
+      positionless::sort_part(p, 0);
+      doNotOptimizeAway(l);
+    });
+    bench::run(b, "splice_sort_part", [&] {
+      auto l = original;
+      list_partitioning p(l.begin(), l.end());
+      positionless::splice_sort_part(l, p, 0);
+      doNotOptimizeAway(l);
+    });
+    bench::run(b, "partitioning by parity (std::stable_partition)", [&] {
+      auto l = original;
+      doNotOptimizeAway(std::stable_partition(l.begin(), l.end(), is_even));
+    });
+    bench::run(b, "partitioning by parity (splice_partition)", [&] {
+      auto l = original;
+      list_partitioning p(l.begin(), l.end());
+      positionless::splice_partition(l, p, 0, is_even);
+      doNotOptimizeAway(p);
+    });
+
+    list halves = original;
+    list_partitioning h(halves.begin(), halves.end());
+    h.add_part_begin(0);
+    h.grow_by(0, n / 2);
+    positionless::splice_sort_part(halves, h, 0);
+    positionless::splice_sort_part(halves, h, 1);
+    bench::run(b, "merging two sorted halves (merge_with_next)", [&] {
+      auto l = halves;
+      list_partitioning p(l.begin(), l.end());
+      p.add_part_begin(0);
+      p.grow_by(0, n / 2);
+      positionless::merge_with_next(p, 0);
+      doNotOptimizeAway(l);
+    });
+    bench::run(b, "merging two sorted halves (splice_merge_with_next)", [&] {
+      auto l = halves;
+      list_partitioning p(l.begin(), l.end());
+      p.add_part_begin(0);
+      p.grow_by(0, n / 2);
+      positionless::splice_merge_with_next(l, p, 0);
+      doNotOptimizeAway(l);
+    });
+  }
+}
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "benchmark_support.hpp"
+
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace bench {
+
+/// Stored benchmark timings, relative to the calibration benchmark.
+///
+/// The JSON file has the form:
+///
+///     {
+///       "tolerance": 0.5,
+///       "benchmarks": {
+///         "<title> / <name>": <time relative to the calibration benchmark>,
+///         ...
+///       }
+///     }
+struct baseline {
+  /// The relative slowdown above which a benchmark is a regression.
+  double tolerance{0.5};
+  /// The relative time of each benchmark, by name.
+  std::map<std::string, double> benchmarks;
+};
+
+namespace detail {
+
+/// A minimal reader of the JSON subset used by baseline files.
+class baseline_reader {
+public:
+  /// An instance reading `text`.
+  explicit baseline_reader(std::string text) : text_(std::move(text)) {}
+
+  /// Returns the baseline read from the text.
+  ///
+  /// Throws `std::runtime_error` if the text is not a valid baseline.
+  baseline read() {
+    baseline r;
+    expect('{');
+    for_each_member([&](const std::string& key) {
+      if (key == "tolerance") {
+        r.tolerance = number();
+      } else if (key == "benchmarks") {
+        expect('{');
+        for_each_member([&](const std::string& name) { r.benchmarks[name] = number(); });
+      } else {
+        throw std::runtime_error("baseline: unexpected key " + key);
+      }
+    });
+    return r;
+  }
+
+private:
+  /// Calls `f` with the key of each member of the object whose `{` was just read, positioned on
+  /// the value of the member.
+  template <typename F> void for_each_member(F f) {
+    if (peek() == '}') {
+      ++position_;
+      return;
+    }
+    for (;;) {
+      const std::string key = string();
+      expect(':');
+      f(key);
+      if (peek() == '}') {
+        ++position_;
+        return;
+      }
+      expect(',');
+    }
+  }
+
+  /// Returns the next non-whitespace character, without consuming it.
+  char peek() {
+    while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_])))
+      ++position_;
+    if (position_ == text_.size())
+      throw std::runtime_error("baseline: unexpected end of file");
+    return text_[position_];
+  }
+
+  /// Consumes `c`, which must be the next non-whitespace character.
+  void expect(char c) {
+    if (peek() != c)
+      throw std::runtime_error(std::string("baseline: expected '") + c + "'");
+    ++position_;
+  }
+
+  /// Reads a string, with `\"` and `\\` escapes.
+  std::string string() {
+    expect('"');
+    std::string r;
+    while (position_ < text_.size() && text_[position_] != '"') {
+      if (text_[position_] == '\\')
+        ++position_;
+      if (position_ < text_.size())
+        r.push_back(text_[position_++]);
+    }
+    expect('"');
+    return r;
+  }
+
+  /// Reads a number.
+  double number() {
+    peek();
+    size_t length = 0;
+    const double r = std::stod(text_.substr(position_), &length);
+    position_ += length;
+    return r;
+  }
+
+  /// The text being read.
+  std::string text_;
+  /// The position of the next character to read.
+  size_t position_{0};
+};
+
+/// Writes `s` to `os` as a JSON string.
+inline void write_json_string(std::ostream& os, const std::string& s) {
+  os << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      os << '\\';
+    os << c;
+  }
+  os << '"';
+}
+
+} // namespace detail
+
+/// Returns the baseline stored in the file at `path`.
+///
+/// Throws `std::runtime_error` if the file cannot be read or is not a valid baseline.
+inline baseline read_baseline(const std::string& path) {
+  std::ifstream in(path);
+  if (!in)
+    throw std::runtime_error("cannot open " + path);
+  std::ostringstream text;
+  text << in.rdbuf();
+  return detail::baseline_reader(text.str()).read();
+}
+
+/// Returns the timings of `measured` relative to the calibration benchmark, by name.
+///
+/// Throws `std::runtime_error` if the calibration benchmark was not run.
+inline std::map<std::string, double> relative_timings(const std::vector<timing>& measured) {
+  double calibration = 0;
+  for (const auto& t : measured) {
+    if (t.name.ends_with(std::string(" / ") + calibration_benchmark))
+      calibration = t.ns;
+  }
+  if (calibration <= 0)
+    throw std::runtime_error("the calibration benchmark was not run");
+  std::map<std::string, double> r;
+  for (const auto& t : measured)
+    r[t.name] = t.ns / calibration;
+  return r;
+}
+
+/// Writes the timings of `measured`, relative to the calibration benchmark, as a baseline with
+/// `tolerance` to the file at `path`.
+inline void write_baseline(
+    const std::string& path, const std::vector<timing>& measured, double tolerance
+) {
+  std::ofstream out(path);
+  if (!out)
+    throw std::runtime_error("cannot open " + path);
+  out << "{\n  \"tolerance\": " << tolerance << ",\n  \"benchmarks\": {";
+  const char* separator = "\n";
+  for (const auto& [name, ratio] : relative_timings(measured)) {
+    out << separator << "    ";
+    detail::write_json_string(out, name);
+    out << ": " << std::setprecision(4) << ratio;
+    separator = ",\n";
+  }
+  out << "\n  }\n}\n";
+}
+
+/// Compares the timings of `measured` with `expected`, prints the comparison to `os`, and returns
+/// `true` if no benchmark of `expected` regressed by more than its tolerance or is missing.
+inline bool check_baseline(
+    const baseline& expected, const std::vector<timing>& measured, std::ostream& os
+) {
+  const auto actual = relative_timings(measured);
+  bool ok = true;
+  os << "\n| benchmark | baseline | measured | change | status |\n|---|---:|---:|---:|---|\n";
+  for (const auto& [name, expected_ratio] : expected.benchmarks) {
+    const auto found = actual.find(name);
+    if (found == actual.end()) {
+      os << "| " << name << " | " << expected_ratio << " | - | - | MISSING |\n";
+      ok = false;
+      continue;
+    }
+    const double change = found->second / expected_ratio - 1;
+    const char* status = "ok";
+    if (change > expected.tolerance) {
+      status = "REGRESSION";
+      ok = false;
+    } else if (change < -expected.tolerance) {
+      status = "faster (consider updating the baseline)";
+    }
+    os << "| " << name << " | " << expected_ratio << " | " << found->second << " | "
+       << std::showpos << std::lround(change * 100) << std::noshowpos << "% | " << status << " |\n";
+  }
+  for (const auto& [name, ratio] : actual) {
+    if (!expected.benchmarks.contains(name))
+      os << "| " << name << " | - | " << ratio << " | - | not in the baseline |\n";
+  }
+  return ok;
+}
+
+} // namespace bench
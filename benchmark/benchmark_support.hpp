@@ -0,0 +1,228 @@
+#pragma once
+
+#include "perf_counters.hpp"
+
+#include <nanobench.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// The command-line configuration of a benchmark run.
+struct options {
+  /// The smallest number of elements to benchmark with.
+  size_t min_size{10};
+  /// The largest number of elements to benchmark with.
+  size_t max_size{100'000};
+  /// Only the groups whose name contains this string are run.
+  std::string filter{};
+};
+
+/// A function running a group of related benchmarks.
+using group_function = void (*)(const options&);
+
+/// A named group of benchmarks.
+struct group {
+  /// The name of the group, used for filtering.
+  const char* name;
+  /// The function running the benchmarks of the group.
+  group_function run;
+};
+
+/// Returns all the registered groups.
+inline std::vector<group>& groups() {
+  static std::vector<group> r;
+  return r;
+}
+
+/// Registers a group of benchmarks on construction.
+struct group_registration {
+  group_registration(const char* name, group_function run) { groups().push_back({name, run}); }
+};
+
+#define BENCHMARK_GROUP_CONCAT_IMPL(a, b) a##b
+#define BENCHMARK_GROUP_CONCAT(a, b) BENCHMARK_GROUP_CONCAT_IMPL(a, b)
+
+/// Defines a group of benchmarks, named `name`, run with the `const options& opts` parameter.
+#define BENCHMARK_GROUP(name)                                                                      \
+  static void BENCHMARK_GROUP_CONCAT(benchmark_group_, __LINE__)(const bench::options& opts);     \
+  static const bench::group_registration BENCHMARK_GROUP_CONCAT(                                   \
+      benchmark_registration_, __LINE__                                                            \
+  )(name, BENCHMARK_GROUP_CONCAT(benchmark_group_, __LINE__));                                     \
+  static void BENCHMARK_GROUP_CONCAT(benchmark_group_, __LINE__)(                                  \
+      [[maybe_unused]] const bench::options& opts                                                  \
+  )
+
+/// The order of the elements in benchmark input data.
+enum class distribution { random, sorted, reversed, few_unique };
+
+/// All the distributions, for iterating over them.
+inline constexpr distribution all_distributions[] = {
+    distribution::random, distribution::sorted, distribution::reversed, distribution::few_unique
+};
+
+/// Returns the name of `d`.
+inline const char* name(distribution d) {
+  switch (d) {
+  case distribution::random:
+    return "random";
+  case distribution::sorted:
+    return "sorted";
+  case distribution::reversed:
+    return "reversed";
+  case distribution::few_unique:
+    return "few_unique";
+  }
+  return "";
+}
+
+/// Returns `n` integers ordered according to `d`, generated deterministically.
+inline std::vector<int> make_data(size_t n, distribution d) {
+  ankerl::nanobench::Rng rng(42);
+  std::vector<int> r(n);
+  for (auto& x : r)
+    x = static_cast<int>(rng() >> 33);
+  switch (d) {
+  case distribution::random:
+    break;
+  case distribution::sorted:
+    std::sort(r.begin(), r.end());
+    break;
+  case distribution::reversed:
+    std::sort(r.begin(), r.end(), std::greater<>{});
+    break;
+  case distribution::few_unique:
+    for (auto& x : r)
+      x %= 8;
+    break;
+  }
+  return r;
+}
+
+/// Returns the sizes to benchmark with: powers of 10 between `opts.min_size` and `opts.max_size`.
+inline std::vector<size_t> sizes(const options& opts) {
+  std::vector<size_t> r;
+  for (size_t n = opts.min_size; n <= opts.max_size; n *= 10)
+    r.push_back(n);
+  return r;
+}
+
+/// Returns a benchmark titled `title`, configured for operations whose cost depends on `n`.
+inline ankerl::nanobench::Bench make_bench(const std::string& title, size_t n) {
+  ankerl::nanobench::Bench b;
+  b.title(title + " (n = " + std::to_string(n) + ")").relative(true).warmup(1);
+  // Small inputs need many iterations per epoch for stable measurements.
+  b.minEpochIterations(std::max<uint64_t>(1, 100'000 / std::max<size_t>(n, 1)));
+  return b;
+}
+
+/// The median wall time of a benchmark, per operation.
+struct timing {
+  /// The title and name of the benchmark.
+  std::string name;
+  /// The median wall time, in nanoseconds.
+  double ns;
+};
+
+/// Returns the timings of the benchmarks run so far.
+inline std::vector<timing>& timings() {
+  static std::vector<timing> r;
+  return r;
+}
+
+/// The name of the benchmark relative to which regressions are measured.
+inline constexpr const char* calibration_benchmark = "calibration: summing n ints";
+
+/// Returns the number of benchmarks whose measured complexity is worse than expected.
+inline size_t& complexity_mismatches() {
+  static size_t r = 0;
+  return r;
+}
+
+/// Returns whether hardware performance counters are collected for each benchmark.
+inline bool& collect_perf_counters() {
+  static bool r = false;
+  return r;
+}
+
+/// The hardware performance counters of a benchmark, per operation.
+struct perf_measurement {
+  /// The title and name of the benchmark.
+  std::string name;
+  /// The median wall time, in nanoseconds.
+  double ns;
+  /// The counter values.
+  perf_values values;
+  /// Whether each counter is available.
+  std::array<bool, perf_events_count> available;
+};
+
+/// Returns the counters measured so far.
+inline std::vector<perf_measurement>& perf_measurements() {
+  static std::vector<perf_measurement> r;
+  return r;
+}
+
+/// Returns the performance counters shared by all benchmarks, opened on first use.
+inline perf_counters& shared_perf_counters() {
+  static perf_counters r;
+  return r;
+}
+
+/// Runs `f` as the benchmark `name` of `b`, recording its timing and, if
+/// `collect_perf_counters()`, measuring its hardware performance counters over about 10ms of
+/// additional runs.
+template <typename F> inline void run(ankerl::nanobench::Bench& b, const std::string& name, F&& f) {
+  using ankerl::nanobench::Result;
+  b.run(name, f);
+  const Result& result = b.results().back();
+  const double seconds = result.median(Result::Measure::elapsed);
+  timings().push_back({result.config().mBenchmarkTitle + " / " + name, seconds * 1e9});
+  if (!collect_perf_counters())
+    return;
+  perf_counters& counters = shared_perf_counters();
+  if (!counters.any_available())
+    return;
+
+  const double iterations = std::clamp(0.01 / std::max(seconds, 1e-12), 1.0, 1e7);
+  counters.start();
+  for (uint64_t k = 0; k < static_cast<uint64_t>(iterations); ++k)
+    f();
+  const perf_values values = counters.stop();
+  perf_measurement m{result.config().mBenchmarkTitle + " / " + name, seconds * 1e9, values, {}};
+  for (size_t k = 0; k < perf_events_count; ++k) {
+    m.values[k] /= static_cast<double>(static_cast<uint64_t>(iterations));
+    m.available[k] = counters.available(k);
+  }
+  perf_measurements().push_back(std::move(m));
+}
+
+/// A container type with its display name, for iterating over container kinds.
+template <typename Container> struct container_kind {
+  using type = Container;
+  const char* name;
+};
+
+/// Calls `f` with a `container_kind` for each benchmarked container of `T`s.
+template <typename T, typename F> inline void for_each_container(F&& f) {
+  f(container_kind<std::vector<T>>{"vector"});
+  f(container_kind<std::deque<T>>{"deque"});
+  f(container_kind<std::list<T>>{"list"});
+  f(container_kind<std::forward_list<T>>{"forward_list"});
+}
+
+/// Returns a container of type `Container` with the elements of `data`.
+template <typename Container, typename T>
+inline Container make_container(const std::vector<T>& data) {
+  return Container(data.begin(), data.end());
+}
+
+} // namespace bench
@@ -0,0 +1,122 @@
+#define ANKERL_NANOBENCH_IMPLEMENT
+#include "baseline.hpp"
+#include "benchmark_support.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+namespace {
+
+/// Prints the command-line usage.
+void print_usage(const char* program) {
+  std::cout << "usage: " << program << " [options]\n"
+            << "  --filter=<text>    only run the groups whose name contains <text>\n"
+            << "  --min-size=<n>     smallest input size (default: 10)\n"
+            << "  --max-size=<n>     largest input size (default: 100000; up to 100000000)\n"
+            << "  --perf-counters    also report hardware performance counters (Linux)\n"
+            << "  --list             list the benchmark groups\n"
+            << "  --write-baseline=<file>  store the timings as a baseline\n"
+            << "  --check-baseline=<file>  fail if timings regressed from the baseline\n"
+            << "  --tolerance=<x>    allowed relative slowdown (default: the baseline's, or 0.5)\n";
+}
+
+/// Prints the hardware performance counters measured by the benchmarks, as a markdown table.
+void print_perf_measurements() {
+  if (bench::perf_measurements().empty()) {
+    std::cerr << "perf counters unavailable: perf_event_open failed (see "
+                 "/proc/sys/kernel/perf_event_paranoid)\n";
+    return;
+  }
+  std::cout << "\n| benchmark | ns/op";
+  for (const char* name : bench::perf_event_names)
+    std::cout << " | " << name << "/op";
+  std::cout << " |\n|---|---:";
+  for (size_t k = 0; k < bench::perf_events_count; ++k)
+    std::cout << "|---:";
+  std::cout << "|\n";
+  for (const auto& m : bench::perf_measurements()) {
+    std::cout << "| " << m.name << " | " << m.ns;
+    for (size_t k = 0; k < bench::perf_events_count; ++k) {
+      if (m.available[k])
+        std::cout << " | " << m.values[k];
+      else
+        std::cout << " | -";
+    }
+    std::cout << " |\n";
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  bench::options opts;
+  bool list = false;
+  std::string write_baseline;
+  std::string check_baseline;
+  std::optional<double> tolerance;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    const auto value = [&](std::string_view prefix) {
+      return std::string(arg.substr(prefix.size()));
+    };
+    if (arg.starts_with("--filter=")) {
+      opts.filter = value("--filter=");
+    } else if (arg.starts_with("--min-size=")) {
+      opts.min_size = std::strtoull(value("--min-size=").c_str(), nullptr, 10);
+    } else if (arg.starts_with("--max-size=")) {
+      opts.max_size = std::strtoull(value("--max-size=").c_str(), nullptr, 10);
+    } else if (arg == "--perf-counters") {
+      bench::collect_perf_counters() = true;
+    } else if (arg.starts_with("--write-baseline=")) {
+      write_baseline = value("--write-baseline=");
+    } else if (arg.starts_with("--check-baseline=")) {
+      check_baseline = value("--check-baseline=");
+    } else if (arg.starts_with("--tolerance=")) {
+      tolerance = std::strtod(value("--tolerance=").c_str(), nullptr);
+    } else if (arg == "--list") {
+      list = true;
+    } else {
+      print_usage(argv[0]);
+      return arg == "--help" ? 0 : 1;
+    }
+  }
+  if (opts.min_size == 0)
+    opts.min_size = 1;
+
+  for (const auto& g : bench::groups()) {
+    if (std::string_view(g.name).find(opts.filter) == std::string_view::npos)
+      continue;
+    if (list) {
+      std::cout << g.name << '\n';
+      continue;
+    }
+    g.run(opts);
+  }
+  if (bench::collect_perf_counters() && !list)
+    print_perf_measurements();
+  // A complexity mismatch fails the run, after the baseline is still written or checked.
+  int status = 0;
+  if (bench::complexity_mismatches() > 0) {
+    std::cerr << bench::complexity_mismatches() << " complexity mismatch(es)\n";
+    status = 1;
+  }
+
+  try {
+    if (!write_baseline.empty())
+      bench::write_baseline(write_baseline, bench::timings(), tolerance.value_or(0.5));
+    if (!check_baseline.empty()) {
+      auto expected = bench::read_baseline(check_baseline);
+      if (tolerance)
+        expected.tolerance = *tolerance;
+      if (!bench::check_baseline(expected, bench::timings(), std::cout))
+        status = 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << '\n';
+    return 2;
+  }
+  return status;
+}
@@ -0,0 +1,216 @@
+// Sweeps of the input size or the number of parts, fitted to complexity classes to check the
+// complexity guarantees documented in the headers.
+#include "benchmark_support.hpp"
+
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/records.hpp"
+
+#include <iostream>
+#include <list>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using ankerl::nanobench::doNotOptimizeAway;
+using positionless::partitioning;
+
+namespace {
+
+/// The complexity classes fitted by nanobench, in increasing order.
+constexpr std::string_view complexity_classes[] = {
+    "O(1)", "O(log n)", "O(n)", "O(n log n)", "O(n^2)", "O(n^3)"
+};
+
+/// Returns the rank of the complexity class `name` in `complexity_classes`.
+size_t complexity_rank(std::string_view name) {
+  for (size_t k = 0; k < std::size(complexity_classes); ++k) {
+    if (complexity_classes[k] == name)
+      return k;
+  }
+  return std::size(complexity_classes);
+}
+
+/// Returns the sizes to sweep: powers of 2 between `opts.min_size` and `opts.max_size`.
+std::vector<size_t> sweep_sizes(const bench::options& opts) {
+  std::vector<size_t> r;
+  for (size_t n = 1; n <= opts.max_size; n *= 2) {
+    if (n >= opts.min_size)
+      r.push_back(n);
+  }
+  return r;
+}
+
+/// Calls `measure(b, name, n)` for each `n` of `sweep_sizes(opts)`, which must run one benchmark
+/// named `name` on `b` for an input of size `n`; then fits the times to complexity classes, and
+/// reports a mismatch if the best fit is more than one class above `expected`.
+///
+/// Neighboring classes (e.g. O(1) and O(log n)) are hard to tell apart from noisy measurements,
+/// so only clear mismatches are reported, like a quadratic operation documented as linear.
+template <typename Measure>
+void sweep(
+    const bench::options& opts, const std::string& title, std::string_view expected, Measure measure
+) {
+  ankerl::nanobench::Bench b;
+  b.title(title).warmup(1).minEpochIterations(10);
+  for (size_t n : sweep_sizes(opts)) {
+    b.complexityN(n);
+    measure(b, "n = " + std::to_string(n), n);
+  }
+
+  const auto fits = b.complexityBigO();
+  if (fits.empty())
+    return;
+  const bool mismatch = complexity_rank(fits.front().name()) > complexity_rank(expected) + 1;
+  std::cout << "\n"
+            << title << ": expected " << expected << ", best fit " << fits.front().name()
+            << (mismatch ? " -- MISMATCH" : " -- ok") << "\n"
+            << fits << "\n";
+  if (mismatch)
+    ++bench::complexity_mismatches();
+}
+
+/// Calls `f` with a `partitioning` of `n` elements of `Container` into 2 parts of `n / 2`
+/// and `n - n / 2` elements.
+template <typename Container, typename F> void with_two_halves(size_t n, F f) {
+  Container c(n);
+  partitioning<typename Container::iterator> p(c.begin(), c.end());
+  p.add_part_begin(0);
+  p.grow_by(0, n / 2);
+  f(p);
+}
+
+/// Calls `f` with a `partitioning` of a 1-element vector into `k` parts, with room for one more.
+template <typename F> void with_parts(size_t k, F f) {
+  std::vector<int> c(1);
+  partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+  p.reserve_parts(k + 1);
+  p.add_parts_end(0, k - 1);
+  f(p);
+}
+
+} // namespace
+
+BENCHMARK_GROUP("complexity/part_size") {
+  sweep(opts, "part_size, vector", "O(1)", [](auto& b, const std::string& name, size_t n) {
+    with_two_halves<std::vector<int>>(n, [&](auto& p) {
+      bench::run(b, name, [&] { doNotOptimizeAway(p.part_size(0)); });
+    });
+  });
+  sweep(opts, "part_size, list", "O(n)", [](auto& b, const std::string& name, size_t n) {
+    with_two_halves<std::list<int>>(n, [&](auto& p) {
+      bench::run(b, name, [&] { doNotOptimizeAway(p.part_size(0)); });
+    });
+  });
+}
+
+BENCHMARK_GROUP("complexity/shrink_by+grow_by") {
+  const auto grow_and_shrink = [](auto& b, const std::string& name, auto& p, size_t n) {
+    bench::run(b, name, [&] {
+      p.shrink_by(1, n - n / 2);
+      p.grow_by(1, n - n / 2);
+      doNotOptimizeAway(p);
+    });
+  };
+  sweep(
+      opts, "shrink_by(1, n/2) + grow_by(1, n/2), vector", "O(1)",
+      [&](auto& b, const std::string& name, size_t n) {
+        with_two_halves<std::vector<int>>(n, [&](auto& p) {
+          p.add_part_end(1);
+          grow_and_shrink(b, name, p, n);
+        });
+      }
+  );
+  sweep(
+      opts, "shrink_by(1, n/2) + grow_by(1, n/2), list", "O(n)",
+      [&](auto& b, const std::string& name, size_t n) {
+        with_two_halves<std::list<int>>(n, [&](auto& p) {
+          p.add_part_end(1);
+          grow_and_shrink(b, name, p, n);
+        });
+      }
+  );
+}
+
+BENCHMARK_GROUP("complexity/parts") {
+  sweep(opts, "part(i) among k parts", "O(1)", [](auto& b, const std::string& name, size_t k) {
+    with_parts(k, [&](auto& p) {
+      bench::run(b, name, [&] { doNotOptimizeAway(p.part(k / 2)); });
+    });
+  });
+  sweep(
+      opts, "add_part_end(k-1) + remove_part(k) among k parts", "O(1)",
+      [](auto& b, const std::string& name, size_t k) {
+        with_parts(k, [&](auto& p) {
+          bench::run(b, name, [&] {
+            p.add_part_end(k - 1);
+            p.remove_part(k);
+            doNotOptimizeAway(p);
+          });
+        });
+      }
+  );
+  sweep(
+      opts, "add_part_begin(0) + remove_part(1) among k parts", "O(n)",
+      [](auto& b, const std::string& name, size_t k) {
+        with_parts(k, [&](auto& p) {
+          bench::run(b, name, [&] {
+            p.add_part_begin(0);
+            p.remove_part(1);
+            doNotOptimizeAway(p);
+          });
+        });
+      }
+  );
+  sweep(
+      opts, "construction + add_parts_end(0, k)", "O(n)",
+      [](auto& b, const std::string& name, size_t k) {
+        std::vector<int> c(1);
+        bench::run(b, name, [&] {
+          partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+          p.add_parts_end(0, k);
+          doNotOptimizeAway(p);
+        });
+      }
+  );
+}
+
+BENCHMARK_GROUP("complexity/algorithms") {
+  sweep(opts, "split_lines of n bytes", "O(n)", [](auto& b, const std::string& name, size_t n) {
+    std::string text;
+    for (size_t k = 0; text.size() < n; ++k)
+      text += std::string(k % 80, 'x') + '\n';
+    bench::run(b, name, [&] {
+      partitioning<const char*> p(text.data(), text.data() + text.size());
+      doNotOptimizeAway(positionless::split_lines(p, 0));
+    });
+  });
+  sweep(
+      opts, "sort_part, vector (includes copying input)", "O(n log n)",
+      [](auto& b, const std::string& name, size_t n) {
+        const auto data = bench::make_data(n, bench::distribution::random);
+        bench::run(b, name, [&] {
+          auto c = data;
+          partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+          positionless::sort_part(p, 0);
+          doNotOptimizeAway(c);
+        });
+      }
+  );
+  sweep(
+      opts, "sort_part, strictly decreasing vector (includes copying input)", "O(n)",
+      [](auto& b, const std::string& name, size_t n) {
+        // Equal elements would end descending runs, which are only reversed if strictly
+        // decreasing.
+        std::vector<int> data(n);
+        std::iota(data.rbegin(), data.rend(), 0);
+        bench::run(b, name, [&] {
+          auto c = data;
+          partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+          positionless::sort_part(p, 0);
+          doNotOptimizeAway(c);
+        });
+      }
+  );
+}
@@ -0,0 +1,88 @@
+// Built once per contract level, as `positionless_contract_benchmarks_<level>`.
+#include "benchmark_support.hpp"
+
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <list>
+#include <string>
+#include <vector>
+
+using ankerl::nanobench::doNotOptimizeAway;
+using positionless::partitioning;
+
+namespace {
+
+/// The name of the contract level this file is compiled with.
+constexpr const char* contract_level_name() {
+  switch (POSITIONLESS_CONTRACT_LEVEL) {
+  case POSITIONLESS_CONTRACT_OFF:
+    return "off";
+  case POSITIONLESS_CONTRACT_CHEAP:
+    return "cheap";
+  case POSITIONLESS_CONTRACT_FULL:
+    return "full";
+  default:
+    return "audit";
+  }
+}
+
+/// Returns a benchmark titled `title`, prefixed with the contract level.
+ankerl::nanobench::Bench make_contract_bench(const std::string& title, size_t n) {
+  return bench::make_bench(std::string("[contracts: ") + contract_level_name() + "] " + title, n);
+}
+
+} // namespace
+
+BENCHMARK_GROUP("contracts/part") {
+  for (size_t k : bench::sizes(opts)) {
+    std::vector<int> c(k);
+    partitioning<std::vector<int>::const_iterator> p(c.begin(), c.end());
+    p.add_parts_end(0, k - 1);
+    auto b = make_contract_bench("is_part_empty(i) for each of k parts", k);
+    bench::run(b, "vector", [&] {
+      size_t sum = 0;
+      for (size_t i = 0; i < p.parts_count(); ++i)
+        sum += p.is_part_empty(i) ? 0 : 1;
+      doNotOptimizeAway(sum);
+    });
+  }
+}
+
+BENCHMARK_GROUP("contracts/grow_by+shrink_by") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = make_contract_bench("grow_by(0, n/2) then shrink_by(0, n/2)", n);
+    const std::list<int> c(n);
+    partitioning<std::list<int>::const_iterator> p(c.begin(), c.end());
+    p.add_part_begin(0);
+    bench::run(b, "list", [&] {
+      p.grow_by(0, n / 2);
+      p.shrink_by(0, n / 2);
+      doNotOptimizeAway(p);
+    });
+  }
+}
+
+BENCHMARK_GROUP("contracts/algorithms") {
+  for (size_t n : bench::sizes(opts)) {
+    const auto data = bench::make_data(n, bench::distribution::random);
+    auto b = make_contract_bench("algorithms (includes copying input)", n);
+    bench::run(b, "split_runs, vector", [&] {
+      partitioning<std::vector<int>::const_iterator> p(data.begin(), data.end());
+      doNotOptimizeAway(positionless::split_runs(p, 0));
+    });
+    bench::run(b, "sort_part, vector", [&] {
+      auto c = data;
+      partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+      positionless::sort_part(p, 0);
+      doNotOptimizeAway(c);
+    });
+    bench::run(b, "sort_part, list", [&] {
+      std::list<int> c(data.begin(), data.end());
+      partitioning<std::list<int>::iterator> p(c.begin(), c.end());
+      positionless::sort_part(p, 0);
+      doNotOptimizeAway(c);
+    });
+  }
+}
@@ -0,0 +1,153 @@
+#include "benchmark_support.hpp"
+
+#include "positionless/async_loader.hpp"
+#include "positionless/compressed_parts.hpp"
+#include "positionless/csv.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/records.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+using ankerl::nanobench::doNotOptimizeAway;
+using positionless::partitioning;
+
+namespace {
+
+/// Returns `n` bytes of text made of lines of 1 to 80 characters.
+std::string make_text(size_t n) {
+  ankerl::nanobench::Rng rng(7);
+  std::string r;
+  r.reserve(n);
+  while (r.size() < n) {
+    const size_t length = 1 + rng.bounded(80);
+    for (size_t k = 0; k < length && r.size() + 1 < n; ++k)
+      r.push_back(static_cast<char>('a' + rng.bounded(26)));
+    r.push_back('\n');
+  }
+  return r;
+}
+
+/// A file with given contents in the temporary directory, removed on destruction.
+struct temporary_file {
+  std::filesystem::path path_;
+
+  explicit temporary_file(const std::string& contents)
+      : path_(std::filesystem::temp_directory_path() / "positionless_benchmark.bin") {
+    std::ofstream(path_, std::ios::binary) << contents;
+  }
+
+  ~temporary_file() { std::filesystem::remove(path_); }
+};
+
+/// Returns the contents of the file at `path`, read with `read()` calls into a vector.
+std::vector<char> read_whole_file(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  std::vector<char> r(std::filesystem::file_size(path));
+  for (size_t done = 0; done < r.size();) {
+    const ssize_t n = ::read(fd, r.data() + done, r.size() - done);
+    if (n <= 0)
+      break;
+    done += static_cast<size_t>(n);
+  }
+  ::close(fd);
+  return r;
+}
+
+} // namespace
+
+BENCHMARK_GROUP("io/split_lines") {
+  for (size_t n : bench::sizes(opts)) {
+    const std::string text = make_text(n);
+    auto b = bench::make_bench("line index of n bytes", n);
+    bench::run(b, "split_lines", [&] {
+      partitioning<const char*> p(text.data(), text.data() + text.size());
+      doNotOptimizeAway(positionless::split_lines(p, 0));
+    });
+    bench::run(b, "vector of line starts (baseline)", [&] {
+      std::vector<const char*> starts{text.data()};
+      for (const char& c : text) {
+        if (c == '\n')
+          starts.push_back(&c + 1);
+      }
+      doNotOptimizeAway(starts);
+    });
+    bench::run(b, "split_at_records into 16 parts", [&] {
+      partitioning<const char*> p(text.data(), text.data() + text.size());
+      positionless::split_at_records(p, 16, '\n');
+      doNotOptimizeAway(p);
+    });
+    bench::run(b, "split_csv_rows", [&] {
+      partitioning<const char*> p(text.data(), text.data() + text.size());
+      positionless::split_csv_rows(p);
+      doNotOptimizeAway(p);
+    });
+  }
+}
+
+BENCHMARK_GROUP("io/file_loading") {
+  for (size_t n : bench::sizes(opts)) {
+    // Tiny files are dominated by opening the file.
+    if (n < 100'000)
+      continue;
+    temporary_file file(make_text(n));
+    auto b = bench::make_bench("loading a file of n bytes", n);
+    bench::run(b, "read() into a vector (baseline)", [&] {
+      doNotOptimizeAway(read_whole_file(file.path_));
+    });
+    bench::run(b, "async_file_loader", [&] {
+      positionless::async_file_loader loader(file.path_);
+      loader.wait_for_all();
+      doNotOptimizeAway(loader.parts());
+    });
+    bench::run(b, "async_file_loader, counting lines while loading", [&] {
+      positionless::async_file_loader loader(file.path_);
+      size_t lines = 0;
+      const char* done = loader.parts().part(0).first;
+      while (loader.wait_for_more()) {
+        const char* end = loader.parts().part(0).second;
+        lines += static_cast<size_t>(std::count(done, end, '\n'));
+        done = end;
+      }
+      doNotOptimizeAway(lines);
+    });
+  }
+}
+
+BENCHMARK_GROUP("io/compressed_parts") {
+  for (size_t n : bench::sizes(opts)) {
+    // Sorted values with small gaps, as in posting lists or sorted keys, in parts of 4096 values.
+    ankerl::nanobench::Rng rng(11);
+    std::vector<uint32_t> data(n);
+    uint32_t value = 0;
+    for (auto& x : data)
+      x = value += static_cast<uint32_t>(rng.bounded(64));
+    partitioning<std::vector<uint32_t>::const_iterator> p(data.begin(), data.end());
+    for (size_t k = 0; (k + 1) * 4096 < n; ++k) {
+      p.add_part_begin(k);
+      p.grow_by(k, 4096);
+    }
+    const positionless::compressed_parts<uint32_t> c(p);
+    std::vector<uint32_t> decoded(n);
+
+    auto b = bench::make_bench("decoding n uint32_t in parts of 4096", n);
+    b.batch(n * sizeof(uint32_t)).unit("byte");
+    bench::run(b, "copying the uncompressed data (baseline)", [&] {
+      std::copy(data.begin(), data.end(), decoded.begin());
+      doNotOptimizeAway(decoded);
+    });
+    bench::run(b, "compressed_parts::decode_part", [&] {
+      auto out = decoded.begin();
+      for (size_t i = 0; i < c.parts_count(); ++i)
+        out = c.decode_part(i, out);
+      doNotOptimizeAway(decoded);
+    });
+  }
+}
@@ -0,0 +1,201 @@
+#include "benchmark_support.hpp"
+
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/segmented_partitioning.hpp"
+
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <vector>
+
+using ankerl::nanobench::doNotOptimizeAway;
+using positionless::partitioning;
+
+BENCHMARK_GROUP("partitioning/construction") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("partitioning construction", n);
+    bench::for_each_container<int>([&](auto kind) {
+      using container = typename decltype(kind)::type;
+      const auto c =
+          bench::make_container<container>(bench::make_data(n, bench::distribution::random));
+      bench::run(b, kind.name, [&] {
+        partitioning<typename container::const_iterator> p(c.begin(), c.end());
+        doNotOptimizeAway(p);
+      });
+    });
+  }
+}
+
+BENCHMARK_GROUP("partitioning/grow_by+shrink_by") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("grow_by(0, n/2) then shrink_by(0, n/2)", n);
+    bench::for_each_container<int>([&](auto kind) {
+      using container = typename decltype(kind)::type;
+      using iterator = typename container::const_iterator;
+      const auto c =
+          bench::make_container<container>(bench::make_data(n, bench::distribution::random));
+      partitioning<iterator> p(c.begin(), c.end());
+      p.add_part_begin(0);
+      if constexpr (std::bidirectional_iterator<iterator>) {
+        bench::run(b, kind.name, [&] {
+          p.grow_by(0, n / 2);
+          p.shrink_by(0, n / 2);
+          doNotOptimizeAway(p);
+        });
+      } else {
+        // Forward iterators cannot shrink; transfer the part back instead.
+        bench::run(b, kind.name, [&] {
+          p.grow_by(0, n / 2);
+          p.transfer_to_next(0);
+          doNotOptimizeAway(p);
+        });
+      }
+    });
+  }
+}
+
+BENCHMARK_GROUP("partitioning/part_size") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("part_size of a part of n/2 elements", n);
+    bench::for_each_container<int>([&](auto kind) {
+      using container = typename decltype(kind)::type;
+      const auto c =
+          bench::make_container<container>(bench::make_data(n, bench::distribution::random));
+      partitioning<typename container::const_iterator> p(c.begin(), c.end());
+      p.add_part_begin(0);
+      p.grow_by(0, n / 2);
+      bench::run(b, kind.name, [&] { doNotOptimizeAway(p.part_size(0)); });
+    });
+  }
+}
+
+BENCHMARK_GROUP("partitioning/add_part+remove_part") {
+  // The cost depends on the number of parts, not on the number of elements.
+  for (size_t k : bench::sizes(opts)) {
+    std::vector<int> c(1);
+    auto b = bench::make_bench("add/remove a part among k parts", k);
+    partitioning<std::vector<int>::const_iterator> p(c.begin(), c.end());
+    p.add_parts_end(0, k - 1);
+    bench::run(b, "add_part_end(0) + remove_part(1)", [&] {
+      p.add_part_end(0);
+      p.remove_part(1);
+      doNotOptimizeAway(p);
+    });
+    bench::run(b, "add_part_begin(0) + remove_part(1)", [&] {
+      p.add_part_begin(0);
+      p.remove_part(1);
+      doNotOptimizeAway(p);
+    });
+    bench::run(b, "add_part_end(k-1) + remove_part(k)", [&] {
+      p.add_part_end(k - 1);
+      p.remove_part(k);
+      doNotOptimizeAway(p);
+    });
+    bench::run(b, "add_parts_end(0, k) + construction", [&] {
+      partitioning<std::vector<int>::const_iterator> q(c.begin(), c.end());
+      q.add_parts_end(0, k);
+      doNotOptimizeAway(q);
+    });
+  }
+}
+
+BENCHMARK_GROUP("partitioning/with_parts") {
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("moving a boundary of 3 parts, one element at a time", n);
+    std::vector<int> c(n);
+    partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+    p.add_parts_begin(0, 2);
+    bench::run(b, "grow_by(1, 1) then shrink_by(1, 1), n times", [&] {
+      for (size_t k = 0; k < n; ++k)
+        p.grow_by(1, 1);
+      for (size_t k = 0; k < n; ++k)
+        p.shrink_by(1, 1);
+      doNotOptimizeAway(p);
+    });
+    bench::run(b, "the same, through with_parts<3>()", [&] {
+      auto h = p.with_parts<3>();
+      for (size_t k = 0; k < n; ++k)
+        h.grow_by(positionless::part_index<1>{}, 1);
+      for (size_t k = 0; k < n; ++k)
+        h.shrink_by(positionless::part_index<1>{}, 1);
+      doNotOptimizeAway(p);
+    });
+  }
+}
+
+BENCHMARK_GROUP("partitioning/memory_footprint") {
+  using vector_partitioning = partitioning<std::vector<int>::iterator>;
+  std::vector<std::vector<size_t>> rows;
+  for (size_t n : bench::sizes(opts)) {
+    auto b = bench::make_bench("adding n parts of 1 element", n);
+    std::vector<int> c(n);
+    const auto add_parts = [&](vector_partitioning& p) {
+      for (size_t k = 1; k < n; ++k) {
+        p.add_part_begin(k - 1);
+        p.grow_by(k - 1, 1);
+      }
+    };
+    bench::run(b, "without reserve_parts", [&] {
+      vector_partitioning p(c.begin(), c.end());
+      add_parts(p);
+      doNotOptimizeAway(p);
+    });
+    bench::run(b, "after reserve_parts(n)", [&] {
+      vector_partitioning p(c.begin(), c.end());
+      p.reserve_parts(n);
+      add_parts(p);
+      doNotOptimizeAway(p);
+    });
+
+    vector_partitioning p(c.begin(), c.end());
+    const size_t constructed = p.memory_footprint();
+    add_parts(p);
+    const size_t grown = p.memory_footprint();
+    p.shrink_to_fit();
+    rows.push_back({n, constructed, grown, p.memory_footprint()});
+  }
+
+  std::cout << "\n| parts | bytes, 1 part | bytes, grown to n parts | after shrink_to_fit |\n"
+            << "|---:|---:|---:|---:|\n";
+  for (const auto& row : rows)
+    std::cout << "| " << row[0] << " | " << row[1] << " | " << row[2] << " | " << row[3] << " |\n";
+}
+
+BENCHMARK_GROUP("partitioning/segmented") {
+  // The size of the pages holding the data.
+  constexpr size_t page_size = 1024;
+  for (size_t n : bench::sizes(opts)) {
+    const auto data = bench::make_data(n, bench::distribution::random);
+    std::vector<std::vector<int>> original_pages;
+    for (size_t k = 0; k < n; k += page_size) {
+      const auto first = data.begin() + static_cast<ptrdiff_t>(k);
+      const auto last = first + static_cast<ptrdiff_t>(std::min(page_size, n - k));
+      original_pages.emplace_back(first, last);
+    }
+
+    auto b = bench::make_bench("pages of 1024 ints", n);
+    positionless::segmented_partitioning<const int> paged(original_pages);
+    bench::run(b, "summing through iterators (std::accumulate)", [&] {
+      doNotOptimizeAway(std::accumulate(paged.part(0).first, paged.part(0).second, 0L));
+    });
+    bench::run(b, "summing through segments (reduce_elements)", [&] {
+      doNotOptimizeAway(positionless::reduce_elements(paged, 0, 0L));
+    });
+    bench::run(b, "sort_part, in place (includes copying input)", [&] {
+      auto pages = original_pages;
+      positionless::segmented_partitioning<int> p(pages);
+      positionless::sort_part(p, 0);
+      doNotOptimizeAway(pages);
+    });
+    bench::run(b, "sort_part, after concatenating the pages", [&] {
+      std::vector<int> c;
+      c.reserve(n);
+      for (const auto& page : original_pages)
+        c.insert(c.end(), page.begin(), page.end());
+      partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+      positionless::sort_part(p, 0);
+      doNotOptimizeAway(c);
+    });
+  }
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bench {
+
+/// The hardware events counted by `perf_counters`.
+enum class perf_event { cycles, instructions, branch_misses, l1d_misses, llc_misses };
+
+/// The number of `perf_event`s.
+inline constexpr size_t perf_events_count = 5;
+
+/// The names of the `perf_event`s, in order.
+inline constexpr const char* perf_event_names[perf_events_count] = {
+    "cycles", "instructions", "branch-misses", "L1D misses", "LLC misses"
+};
+
+/// The values of the `perf_event`s, in order.
+using perf_values = std::array<double, perf_events_count>;
+
+/// A group of hardware performance counters of the calling thread, read with `perf_event_open`.
+///
+/// Counters that the kernel or the hardware do not support (e.g. in virtual machines, or when
+/// `/proc/sys/kernel/perf_event_paranoid` forbids it) are reported as missing.
+class perf_counters {
+public:
+  /// An instance opening the counters, disabled.
+  perf_counters() {
+#if defined(__linux__)
+    constexpr uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                                       | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const std::array<std::pair<uint32_t, uint64_t>, perf_events_count> configs{{
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, l1d_read_miss},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    }};
+    for (size_t k = 0; k < perf_events_count; ++k) {
+      perf_event_attr attr;
+      std::memset(&attr, 0, sizeof(attr));
+      attr.size = sizeof(attr);
+      attr.type = configs[k].first;
+      attr.config = configs[k].second;
+      attr.disabled = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      // Counters are read separately, so that an unsupported one does not disable the others.
+      fds_[k] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+  }
+
+  perf_counters(const perf_counters&) = delete;
+  perf_counters& operator=(const perf_counters&) = delete;
+
+  ~perf_counters() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+      if (fd >= 0)
+        ::close(fd);
+    }
+#endif
+  }
+
+  /// Returns `true` if at least one counter is available.
+  bool any_available() const {
+    for (size_t k = 0; k < perf_events_count; ++k) {
+      if (available(k))
+        return true;
+    }
+    return false;
+  }
+
+  /// Returns `true` if the `k`th counter is available.
+  bool available(size_t k) const { return fds_[k] >= 0; }
+
+  /// Resets and starts the counters.
+  void start() {
+#if defined(__linux__)
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  /// Stops the counters and returns their values; missing counters are 0.
+  perf_values stop() {
+    perf_values r{};
+#if defined(__linux__)
+    for (int fd : fds_) {
+      if (fd >= 0)
+        ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (size_t k = 0; k < perf_events_count; ++k) {
+      uint64_t value = 0;
+      if (fds_[k] >= 0 && ::read(fds_[k], &value, sizeof(value)) == sizeof(value))
+        r[k] = static_cast<double>(value);
+    }
+#endif
+    return r;
+  }
+
+private:
+  /// The file descriptors of the counters, or -1 for missing counters.
+  std::array<int, perf_events_count> fds_{-1, -1, -1, -1, -1};
+};
+
+} // namespace bench
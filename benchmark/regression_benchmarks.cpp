@@ -0,0 +1,82 @@
+// A fixed subset of benchmarks, compared against a stored baseline by the `perf` ctest label.
+#include "benchmark_support.hpp"
+
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/records.hpp"
+
+#include <list>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using ankerl::nanobench::doNotOptimizeAway;
+using positionless::partitioning;
+
+namespace {
+
+/// The size of the inputs; fixed, so that the results are comparable across runs.
+constexpr size_t n = 10'000;
+
+} // namespace
+
+BENCHMARK_GROUP("regression") {
+  auto b = bench::make_bench("regression", n);
+  const auto data = bench::make_data(n, bench::distribution::random);
+
+  // The times of the other benchmarks are compared relative to this one, to factor out the speed
+  // of the machine.
+  bench::run(b, bench::calibration_benchmark, [&] {
+    doNotOptimizeAway(std::accumulate(data.begin(), data.end(), 0L));
+  });
+
+  std::vector<int> c(n);
+  partitioning<std::vector<int>::iterator> parts(c.begin(), c.end());
+  parts.add_parts_end(0, n - 1);
+  bench::run(b, "part(i) for each of n parts", [&] {
+    size_t sum = 0;
+    for (size_t i = 0; i < parts.parts_count(); ++i)
+      sum += static_cast<size_t>(parts.part(i).second - parts.part(i).first);
+    doNotOptimizeAway(sum);
+  });
+
+  partitioning<std::vector<int>::iterator> halves(c.begin(), c.end());
+  halves.add_part_begin(0);
+  bench::run(b, "grow_by(0, 1) then shrink_by(0, 1) n times, vector", [&] {
+    for (size_t k = 0; k < n; ++k)
+      halves.grow_by(0, 1);
+    for (size_t k = 0; k < n; ++k)
+      halves.shrink_by(0, 1);
+    doNotOptimizeAway(halves);
+  });
+
+  std::list<int> l(n);
+  partitioning<std::list<int>::iterator> list_halves(l.begin(), l.end());
+  list_halves.add_part_begin(0);
+  bench::run(b, "grow_by(0, n) then shrink_by(0, n), list", [&] {
+    list_halves.grow_by(0, n);
+    list_halves.shrink_by(0, n);
+    doNotOptimizeAway(list_halves);
+  });
+
+  bench::run(b, "add_part_end(0) + remove_part(1) among n parts", [&] {
+    parts.add_part_end(0);
+    parts.remove_part(1);
+    doNotOptimizeAway(parts);
+  });
+
+  bench::run(b, "sort_part, vector (includes copying input)", [&] {
+    auto v = data;
+    partitioning<std::vector<int>::iterator> p(v.begin(), v.end());
+    positionless::sort_part(p, 0);
+    doNotOptimizeAway(v);
+  });
+
+  std::string text;
+  for (size_t k = 0; text.size() < n; ++k)
+    text += std::string(k % 80, 'x') + '\n';
+  bench::run(b, "split_lines", [&] {
+    partitioning<const char*> p(text.data(), text.data() + text.size());
+    doNotOptimizeAway(positionless::split_lines(p, 0));
+  });
+}
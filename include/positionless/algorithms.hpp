@@ -1,10 +1,13 @@
 #pragma once
 
 #include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
 #include "positionless/partitioning.hpp"
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
+#include <utility>
 
 namespace positionless {
 
@@ -23,7 +26,168 @@ inline void swap_first(partitioning<Iterator>& p, size_t i, size_t j) {
   auto [begin_i, end_i] = p.part(i);
   auto [begin_j, end_j] = p.part(j);
 
-  std::iter_swap(begin_i, begin_j);
+  std::ranges::iter_swap(begin_i, begin_j);
+}
+
+/// Calls `f` with each part of `p`, as returned by `p.part(j)`, in order.
+///
+/// - Complexity: O(p.parts_count()) calls of `f`
+template <std::forward_iterator Iterator, typename F>
+inline void for_each_part(const partitioning<Iterator>& p, F f) {
+  for (size_t j = 0; j < p.parts_count(); ++j)
+    f(p.part(j));
+}
+
+/// Returns the result of folding `transform(p.part(j))`, for each part `j` of `p` in order, into
+/// `init` with `reduce`.
+///
+/// - Complexity: O(p.parts_count()) calls of `transform` and `reduce`
+template <std::forward_iterator Iterator, typename T, typename Reduce, typename Transform>
+inline T reduce_parts(const partitioning<Iterator>& p, T init, Reduce reduce, Transform transform) {
+  for (size_t j = 0; j < p.parts_count(); ++j)
+    init = reduce(std::move(init), transform(p.part(j)));
+  return init;
+}
+
+/// Splits the `i`th part of `p` into its maximal non-descending runs with respect to `comp`, one
+/// part per run, and returns the number of runs.
+///
+/// An empty part is left as a single (empty) run.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(part_size(i) + runs * (p.parts_count() - i))
+template <std::forward_iterator Iterator, typename Compare = std::less<>>
+inline size_t split_runs(partitioning<Iterator>& p, size_t i, Compare comp = {}) {
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("split_runs", {"part", i});
+
+  size_t runs = 1;
+  auto [first, last] = p.part(i);
+  while (first != last) {
+    const Iterator run_end = std::is_sorted_until(first, last, comp);
+    if (run_end == last)
+      break;
+    p.add_part_begin(i + runs - 1);
+    p.grow_by(i + runs - 1, static_cast<size_t>(std::distance(first, run_end)));
+    first = run_end;
+    ++runs;
+  }
+  return runs;
+}
+
+/// Merges the sorted parts `i` and `i + 1` of `p` into a single sorted part `i`.
+///
+/// - Precondition: `i + 1 < p.parts_count()`
+/// - Precondition: parts `i` and `i + 1` are sorted with respect to `comp`
+/// - Complexity: O(n) comparisons if additional memory is available, O(n log n) otherwise, where
+///   `n` is the size of both parts.
+template <std::bidirectional_iterator Iterator, typename Compare = std::less<>>
+inline void merge_with_next(partitioning<Iterator>& p, size_t i, Compare comp = {}) {
+  PRECONDITION(i + 1 < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("merge_with_next", {"part", i});
+
+  const auto [first, middle] = p.part(i);
+  const auto last = p.part(i + 1).second;
+  AUDIT_PRECONDITION(std::is_sorted(first, middle, comp));
+  AUDIT_PRECONDITION(std::is_sorted(middle, last, comp));
+  std::inplace_merge(first, middle, last, comp);
+  p.remove_part(i + 1);
+}
+
+/// Merges the `runs` sorted parts of `p` starting at part `i` into a single sorted part `i`.
+///
+/// The parts are merged from the last to the first, keeping the merged parts on a stack whose
+/// sizes at least double from each part to the next, so that merges are balanced and the parts
+/// whose boundaries are removed by each merge are few.
+///
+/// - Precondition: `runs >= 1`
+/// - Precondition: `i + runs <= p.parts_count()`
+/// - Precondition: parts [i, i + runs) are sorted with respect to `comp`
+/// - Complexity: O(n log runs) comparisons if additional memory is available, where `n` is the
+///   total size of the parts.
+template <std::bidirectional_iterator Iterator, typename Compare = std::less<>>
+inline void merge_parts(partitioning<Iterator>& p, size_t i, size_t runs, Compare comp = {}) {
+  PRECONDITION(runs >= 1);
+  PRECONDITION(i + runs <= p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("merge_parts", {"part", i}, {"runs", runs});
+
+  // The stack holds parts [top, top + stack_size), from top to bottom.
+  size_t top = i + runs - 1;
+  size_t stack_size = 1;
+  while (top > i) {
+    --top;
+    ++stack_size;
+    while (stack_size > 1 && p.part_size(top + 1) <= 2 * p.part_size(top)) {
+      merge_with_next(p, top, comp);
+      --stack_size;
+    }
+  }
+  for (; stack_size > 1; --stack_size)
+    merge_with_next(p, top, comp);
+}
+
+namespace detail {
+
+/// The minimum length of the runs merged by `sort_part`.
+inline constexpr size_t min_sort_run = 32;
+
+/// Sorts a prefix of [first, last) in place and returns its end.
+///
+/// The prefix is the maximal non-descending run starting at `first`, or the maximal strictly
+/// descending one (reversed), extended by insertion to `min_run` elements if shorter.
+template <std::bidirectional_iterator Iterator, typename Compare>
+inline Iterator sort_next_run(Iterator first, Iterator last, Compare& comp, size_t min_run) {
+  if (first == last)
+    return last;
+
+  Iterator run_end = std::next(first);
+  size_t size = 1;
+  if (run_end != last && comp(*run_end, *first)) {
+    for (Iterator previous = first; run_end != last && comp(*run_end, *previous); ++size)
+      previous = run_end++;
+    std::reverse(first, run_end);
+  } else {
+    for (Iterator previous = first; run_end != last && !comp(*run_end, *previous); ++size)
+      previous = run_end++;
+  }
+
+  for (; size < min_run && run_end != last; ++run_end, ++size) {
+    const Iterator position = std::upper_bound(first, run_end, *run_end, comp);
+    std::rotate(position, run_end, std::next(run_end));
+  }
+  return run_end;
+}
+
+} // namespace detail
+
+/// Sorts the elements of the `i`th part of `p` with respect to `comp`, using a natural merge sort
+/// that keeps the sorted runs as parts of `p`, and returns the number of runs that were merged.
+///
+/// The part is first split into sorted runs: non-descending runs, and strictly descending runs
+/// (which are reversed), short runs being extended by insertion. The runs are then merged with
+/// `merge_parts`. The sort is stable.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(n log n) comparisons if additional memory is available, and O(n) for sorted or
+///   strictly decreasing parts, where `n` is the size of the part.
+template <std::bidirectional_iterator Iterator, typename Compare = std::less<>>
+inline size_t sort_part(partitioning<Iterator>& p, size_t i, Compare comp = {}) {
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("sort_part", {"part", i});
+
+  auto [first, last] = p.part(i);
+  size_t runs = 1;
+  for (;;) {
+    const Iterator run_end = detail::sort_next_run(first, last, comp, detail::min_sort_run);
+    if (run_end == last)
+      break;
+    p.add_part_begin(i + runs - 1);
+    p.grow_by(i + runs - 1, static_cast<size_t>(std::distance(first, run_end)));
+    first = run_end;
+    ++runs;
+  }
+  merge_parts(p, i, runs, comp);
+  return runs;
 }
 
 } // namespace positionless
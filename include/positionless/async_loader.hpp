@@ -0,0 +1,257 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace positionless {
+
+namespace detail {
+
+/// An open file descriptor, closed on destruction.
+class file_descriptor {
+public:
+  /// An instance owning `fd`, or owning nothing if `fd < 0`.
+  explicit file_descriptor(int fd = -1) noexcept : fd_(fd) {}
+
+  file_descriptor(const file_descriptor&) = delete;
+  file_descriptor& operator=(const file_descriptor&) = delete;
+
+  ~file_descriptor() {
+    if (fd_ >= 0)
+      ::close(fd_);
+  }
+
+  /// Returns the file descriptor.
+  [[nodiscard]]
+  int get() const noexcept {
+    return fd_;
+  }
+
+private:
+  /// The file descriptor, or -1.
+  int fd_;
+};
+
+} // namespace detail
+
+/// A loader that reads a whole file into memory with concurrent reads, exposing the data as a
+/// partitioning that grows as reads complete.
+///
+/// The partitioning always has two parts:
+/// - part 0: the loaded prefix of the file;
+/// - part 1: the rest of the file, whose contents are not yet available.
+///
+/// The file is read in chunks of `chunk_size` bytes by background threads issuing `pread`s, so
+/// that the loaded prefix can be processed while the rest of the file is being read.
+class async_file_loader {
+public:
+  /// An instance starting to load the file at `path`, in chunks of `chunk_size` bytes, using
+  /// `threads` concurrent readers.
+  ///
+  /// Throws `std::system_error` if the file cannot be opened.
+  ///
+  /// - Precondition: `chunk_size > 0`
+  /// - Precondition: `threads > 0`
+  explicit async_file_loader(
+      const std::filesystem::path& path, size_t chunk_size = size_t{1} << 20, size_t threads = 4
+  );
+
+  async_file_loader(const async_file_loader&) = delete;
+  async_file_loader& operator=(const async_file_loader&) = delete;
+
+  /// Stops the readers and closes the file.
+  ~async_file_loader();
+
+  /// Waits until more data is loaded and grows part 0 to cover it; returns `false` if the whole
+  /// file was already loaded.
+  ///
+  /// Rethrows the exception of any failed read.
+  bool wait_for_more();
+
+  /// Waits until the whole file is loaded, making part 1 empty.
+  ///
+  /// Rethrows the exception of any failed read.
+  void wait_for_all() {
+    while (wait_for_more()) {
+    }
+  }
+
+  /// Returns the partitioning of the file contents.
+  [[nodiscard]]
+  const partitioning<const char*>& parts() const noexcept {
+    return parts_;
+  }
+
+  /// Returns the size of the file.
+  [[nodiscard]]
+  size_t file_size() const noexcept {
+    return size_;
+  }
+
+private:
+  /// Returns a read-only file descriptor for the file at `path`.
+  ///
+  /// Throws `std::system_error` if the file cannot be opened.
+  static int open_file(const std::filesystem::path& path);
+
+  /// Reads chunks until all of them are claimed, or reading is stopped.
+  void read_chunks() noexcept;
+
+  /// The file being read.
+  detail::file_descriptor fd_;
+  /// The size of the file.
+  size_t size_{0};
+  /// The size of each read.
+  size_t chunk_size_;
+  /// The contents of the file.
+  std::unique_ptr<char[]> buffer_;
+  /// The loaded and pending parts of `buffer_`.
+  partitioning<const char*> parts_;
+
+  /// The number of chunks in the file.
+  size_t chunks_count_{0};
+  /// The index of the next chunk to be read by a reader.
+  std::atomic<size_t> next_chunk_{0};
+  /// The number of chunks in part 0.
+  size_t loaded_chunks_{0};
+  /// `true` if readers should stop before claiming more chunks.
+  std::atomic<bool> stopping_{false};
+
+  /// Protects `completed_` and `error_`.
+  std::mutex mutex_;
+  /// Signaled when a chunk completes.
+  std::condition_variable chunk_completed_;
+  /// For each chunk, whether its read completed.
+  std::vector<char> completed_;
+  /// The exception of the first failed read, if any.
+  std::exception_ptr error_;
+
+  /// The reading threads.
+  std::vector<std::thread> readers_;
+};
+
+// Inline definitions
+
+inline async_file_loader::async_file_loader(
+    const std::filesystem::path& path, size_t chunk_size, size_t threads
+)
+    : fd_(open_file(path)), chunk_size_(chunk_size), parts_(nullptr, nullptr) {
+  PRECONDITION(chunk_size > 0);
+  PRECONDITION(threads > 0);
+
+  struct stat st {};
+  if (::fstat(fd_.get(), &st) != 0) {
+    const int error = errno;
+    throw std::system_error(error, std::generic_category(), "cannot stat " + path.string());
+  }
+  ::posix_fadvise(fd_.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  size_ = static_cast<size_t>(st.st_size);
+  buffer_ = std::make_unique_for_overwrite<char[]>(size_);
+  parts_ = partitioning<const char*>(buffer_.get(), buffer_.get() + size_);
+  parts_.add_part_begin(0);
+  chunks_count_ = (size_ + chunk_size_ - 1) / chunk_size_;
+  completed_.assign(chunks_count_, false);
+
+  threads = std::min(threads, chunks_count_);
+  readers_.reserve(threads);
+  try {
+    for (size_t t = 0; t < threads; ++t)
+      readers_.emplace_back([this] { read_chunks(); });
+  } catch (...) {
+    // The destructor does not run: the readers already started are stopped here.
+    stopping_ = true;
+    for (auto& r : readers_)
+      r.join();
+    throw;
+  }
+}
+
+inline async_file_loader::~async_file_loader() {
+  stopping_ = true;
+  for (auto& r : readers_)
+    r.join();
+}
+
+inline int async_file_loader::open_file(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    const int error = errno;
+    throw std::system_error(error, std::generic_category(), "cannot open " + path.string());
+  }
+  return fd;
+}
+
+inline bool async_file_loader::wait_for_more() {
+  if (loaded_chunks_ == chunks_count_)
+    return false;
+
+  size_t newly_loaded = 0;
+  {
+    std::unique_lock lock(mutex_);
+    chunk_completed_.wait(lock, [&] { return completed_[loaded_chunks_] || error_; });
+    if (error_)
+      std::rethrow_exception(error_);
+    for (size_t c = loaded_chunks_; c < chunks_count_ && completed_[c]; ++c)
+      ++newly_loaded;
+  }
+
+  const size_t begin = loaded_chunks_ * chunk_size_;
+  loaded_chunks_ += newly_loaded;
+  const size_t end = std::min(size_, loaded_chunks_ * chunk_size_);
+  parts_.grow_by(0, end - begin);
+  return true;
+}
+
+inline void async_file_loader::read_chunks() noexcept {
+  while (!stopping_) {
+    const size_t chunk = next_chunk_++;
+    if (chunk >= chunks_count_)
+      return;
+
+    const size_t begin = chunk * chunk_size_;
+    const size_t end = std::min(size_, begin + chunk_size_);
+    try {
+      POSITIONLESS_TRACE_SCOPE("async_file_loader: read chunk", {"chunk", chunk});
+      for (size_t done = begin; done < end;) {
+        const ssize_t r =
+            ::pread(fd_.get(), buffer_.get() + done, end - done, static_cast<off_t>(done));
+        if (r < 0 && errno == EINTR)
+          continue;
+        if (r < 0)
+          throw std::system_error(errno, std::generic_category(), "async_file_loader: pread");
+        if (r == 0)
+          throw std::system_error(
+              std::make_error_code(std::errc::io_error), "async_file_loader: file shrunk"
+          );
+        done += static_cast<size_t>(r);
+      }
+      std::lock_guard lock(mutex_);
+      completed_[chunk] = true;
+    } catch (...) {
+      std::lock_guard lock(mutex_);
+      if (!error_)
+        error_ = std::current_exception();
+    }
+    chunk_completed_.notify_all();
+  }
+}
+
+} // namespace positionless
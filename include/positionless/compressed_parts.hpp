@@ -0,0 +1,226 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace positionless {
+
+namespace detail {
+
+/// The number of differences decoded at once by `compressed_parts::decode_part`; a block of
+/// differences of width `w` fills exactly `w` words.
+inline constexpr size_t compressed_block_size = 64;
+
+/// Writes to `deltas` the `compressed_block_size` differences of width `Width` bit-packed in
+/// `words`.
+///
+/// The positions of the differences are constants, so each one takes a fixed shift and mask, and
+/// the loop is unrolled without branches.
+template <std::unsigned_integral T, unsigned Width>
+inline void unpack_block(const uint64_t* words, T* deltas) noexcept {
+  constexpr uint64_t mask = Width == 64 ? ~uint64_t{0} : (uint64_t{1} << Width) - 1;
+  [&]<size_t... J>(std::index_sequence<J...>) {
+    (
+        [&] {
+          constexpr size_t word = J * Width / 64;
+          constexpr size_t shift = J * Width % 64;
+          uint64_t bits = words[word] >> shift;
+          if constexpr (shift + Width > 64)
+            bits |= words[word + 1] << (64 - shift);
+          deltas[J] = static_cast<T>(bits & mask);
+        }(),
+        ...
+    );
+  }(std::make_index_sequence<compressed_block_size>{});
+}
+
+/// `unpack_block<T, w>` for each width `w` of the differences of `T`s, at index `w - 1`.
+template <std::unsigned_integral T>
+inline constexpr auto block_unpackers = []<unsigned... W>(std::integer_sequence<unsigned, W...>) {
+  return std::array<void (*)(const uint64_t*, T*) noexcept, sizeof...(W)>{
+      &unpack_block<T, W + 1>...
+  };
+}(std::make_integer_sequence<unsigned, std::numeric_limits<T>::digits>{});
+
+} // namespace detail
+
+/// An immutable, compressed copy of the parts of a partitioning of unsigned integers, where each
+/// part can be decoded independently of the others.
+///
+/// Each part is stored as its first value followed by the differences between consecutive values
+/// (modulo 2^N, for N-bit integers), bit-packed with the smallest width that fits all of them.
+/// The data is stored exactly for any input, but sorted parts with small gaps compress best.
+template <std::unsigned_integral T> class compressed_parts {
+public:
+  /// An instance holding the compressed contents of the parts of `p`.
+  ///
+  /// - Complexity: O(n + p.parts_count())
+  template <std::forward_iterator Iterator>
+    requires std::convertible_to<std::iter_value_t<Iterator>, T>
+  explicit compressed_parts(const partitioning<Iterator>& p);
+
+  /// Returns the number of parts.
+  [[nodiscard]]
+  size_t parts_count() const noexcept {
+    return directory_.size();
+  }
+
+  /// Returns the number of elements in the `i`th part.
+  ///
+  /// - Precondition: `i < parts_count()`
+  [[nodiscard]]
+  size_t part_size(size_t i) const noexcept;
+
+  /// Writes the elements of the `i`th part to `out`, returning the end of the written range.
+  ///
+  /// - Precondition: `i < parts_count()`
+  /// - Complexity: O(part_size(i))
+  template <std::output_iterator<T> Out> Out decode_part(size_t i, Out out) const;
+
+  /// Returns the elements of the `i`th part.
+  ///
+  /// - Precondition: `i < parts_count()`
+  [[nodiscard]]
+  std::vector<T> part(size_t i) const;
+
+  /// Returns the number of bytes used to store the compressed data and the part directory.
+  [[nodiscard]]
+  size_t compressed_bytes() const noexcept {
+    return words_.size() * sizeof(uint64_t) + directory_.size() * sizeof(part_entry);
+  }
+
+private:
+  /// The location and encoding of a compressed part.
+  struct part_entry {
+    /// The index in `words_` of the first word holding the differences.
+    size_t first_word;
+    /// The number of elements in the part.
+    size_t size;
+    /// The first element of the part, if not empty.
+    T base;
+    /// The number of bits of each difference.
+    unsigned width;
+  };
+
+  /// The bit-packed differences of all the parts, followed by a padding word.
+  std::vector<uint64_t> words_;
+  /// The entry of each part.
+  std::vector<part_entry> directory_;
+};
+
+// Inline definitions
+
+template <std::unsigned_integral T>
+template <std::forward_iterator Iterator>
+  requires std::convertible_to<std::iter_value_t<Iterator>, T>
+inline compressed_parts<T>::compressed_parts(const partitioning<Iterator>& p) {
+  directory_.reserve(p.parts_count());
+  for (size_t i = 0; i < p.parts_count(); ++i) {
+    const auto [first, last] = p.part(i);
+    part_entry e{words_.size(), 0, T{}, 0};
+
+    // First pass: the size, and the width of the largest difference.
+    T width_mask = 0;
+    if (first != last) {
+      e.base = static_cast<T>(*first);
+      T previous = e.base;
+      for (auto it = std::next(first); it != last; ++it) {
+        const auto value = static_cast<T>(*it);
+        width_mask |= static_cast<T>(value - previous);
+        previous = value;
+        ++e.size;
+      }
+      ++e.size;
+    }
+    e.width = static_cast<unsigned>(std::bit_width(width_mask));
+
+    // Second pass: pack the differences.
+    const size_t bits = (e.size == 0 ? 0 : e.size - 1) * e.width;
+    words_.resize(words_.size() + (bits + 63) / 64, 0);
+    if (e.width != 0) {
+      size_t position = e.first_word * 64;
+      T previous = e.base;
+      for (auto it = std::next(first); it != last; ++it) {
+        const auto value = static_cast<T>(*it);
+        const auto delta = static_cast<uint64_t>(static_cast<T>(value - previous));
+        const size_t shift = position % 64;
+        words_[position / 64] |= delta << shift;
+        if (shift + e.width > 64)
+          words_[position / 64 + 1] |= delta >> (64 - shift);
+        position += e.width;
+        previous = value;
+      }
+    }
+    directory_.push_back(e);
+  }
+  // Lets decoding read the word after the last one unconditionally.
+  words_.push_back(0);
+}
+
+template <std::unsigned_integral T>
+inline size_t compressed_parts<T>::part_size(size_t i) const noexcept {
+  PRECONDITION(i < parts_count());
+  return directory_[i].size;
+}
+
+template <std::unsigned_integral T>
+template <std::output_iterator<T> Out>
+inline Out compressed_parts<T>::decode_part(size_t i, Out out) const {
+  PRECONDITION(i < parts_count());
+  const part_entry& e = directory_[i];
+  if (e.size == 0)
+    return out;
+
+  T value = e.base;
+  *out++ = value;
+  if (e.width == 0) {
+    // All the elements are equal.
+    return std::fill_n(out, e.size - 1, value);
+  }
+
+  // Whole blocks of differences are unpacked with constant shifts, then summed.
+  const uint64_t* words = words_.data() + e.first_word;
+  const auto unpack = detail::block_unpackers<T>[e.width - 1];
+  const size_t blocks = (e.size - 1) / detail::compressed_block_size;
+  T block[detail::compressed_block_size];
+  for (size_t b = 0; b < blocks; ++b, words += e.width) {
+    unpack(words, block);
+    for (T& x : block)
+      x = value = static_cast<T>(value + x);
+    out = std::copy(std::begin(block), std::end(block), out);
+  }
+
+  // The remaining differences are decoded one at a time.
+  const uint64_t mask = e.width == 64 ? ~uint64_t{0} : (uint64_t{1} << e.width) - 1;
+  size_t position = 0;
+  for (size_t k = 1 + blocks * detail::compressed_block_size; k < e.size; ++k) {
+    const size_t shift = position % 64;
+    const uint64_t* w = words + position / 64;
+    // `(w[1] << 1) << (63 - shift)` is `w[1] << (64 - shift)`, without shifting by 64.
+    const uint64_t bits = (w[0] >> shift) | ((w[1] << 1) << (63 - shift));
+    value = static_cast<T>(value + static_cast<T>(bits & mask));
+    *out++ = value;
+    position += e.width;
+  }
+  return out;
+}
+
+template <std::unsigned_integral T>
+inline std::vector<T> compressed_parts<T>::part(size_t i) const {
+  PRECONDITION(i < parts_count());
+  std::vector<T> r(directory_[i].size);
+  decode_part(i, r.begin());
+  return r;
+}
+
+} // namespace positionless
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "positionless/detail/byte_scan.hpp"
+#include "positionless/detail/parallel.hpp"
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace positionless {
+
+namespace detail {
+
+/// Appends to `ends` the end of each CSV row in [first, last), i.e., the position after each
+/// newline outside quotes, assuming that [first, last) starts inside a quoted field iff
+/// `in_quotes`.
+inline void append_csv_row_ends(
+    const char* first, const char* last, char quote, bool in_quotes, std::vector<const char*>& ends
+) {
+  for_each_byte_of(first, last, quote, '\n', [&](const char* c) {
+    if (*c == quote)
+      in_quotes = !in_quotes;
+    else if (!in_quotes)
+      ends.push_back(c + 1);
+  });
+}
+
+} // namespace detail
+
+/// Splits the only part of `p`, holding CSV (or TSV) data, into one part per row.
+///
+/// Each part contains a row and its terminating newline; newlines inside quoted fields do not end
+/// rows. The data is scanned a machine word at a time; if `threads > 1`, it is scanned in as many
+/// chunks in parallel: a first pass counts the quotes of each chunk to determine whether each
+/// chunk starts inside a quoted field, and a second pass finds the row ends of each chunk.
+///
+/// - Precondition: `p.parts_count() == 1`
+/// - Precondition: `threads >= 1`
+/// - Complexity: O(n / threads + number of rows)
+inline void split_csv_rows(partitioning<const char*>& p, size_t threads = 1, char quote = '"') {
+  PRECONDITION(p.parts_count() == 1);
+  PRECONDITION(threads >= 1);
+
+  const auto [first, last] = p.part(0);
+  const size_t n = static_cast<size_t>(last - first);
+  const size_t chunks = std::max<size_t>(1, std::min(threads, n / 4096));
+
+  std::vector<std::vector<const char*>> ends(chunks);
+  if (chunks == 1) {
+    detail::append_csv_row_ends(first, last, quote, false, ends[0]);
+  } else {
+    const auto chunk = [&](size_t c) {
+      return std::pair{first + n * c / chunks, first + n * (c + 1) / chunks};
+    };
+    const auto in_parallel = [&](auto&& f) { detail::parallel_for(chunks, f, chunks); };
+
+    // Whether each chunk starts in quotes depends on the parity of the quotes before it.
+    std::vector<size_t> quotes(chunks);
+    in_parallel([&](size_t c) {
+      POSITIONLESS_TRACE_SCOPE("split_csv_rows: count quotes", {"chunk", c});
+      quotes[c] = detail::count_byte(chunk(c).first, chunk(c).second, quote);
+    });
+    std::vector<char> in_quotes(chunks, false);
+    for (size_t c = 1; c < chunks; ++c)
+      in_quotes[c] = static_cast<char>((in_quotes[c - 1] != 0) != (quotes[c - 1] % 2 != 0));
+
+    in_parallel([&](size_t c) {
+      POSITIONLESS_TRACE_SCOPE("split_csv_rows: find row ends", {"chunk", c});
+      detail::append_csv_row_ends(chunk(c).first, chunk(c).second, quote, in_quotes[c], ends[c]);
+    });
+  }
+
+  const char* done = first;
+  for (const auto& chunk_ends : ends) {
+    for (const char* e : chunk_ends) {
+      if (e == last)
+        break;
+      p.add_part_begin(p.parts_count() - 1);
+      p.grow_by(p.parts_count() - 2, static_cast<size_t>(e - done));
+      done = e;
+    }
+  }
+}
+
+/// Splits the `i`th part of `p`, holding one CSV row, into one part per field, and returns the
+/// number of fields.
+///
+/// Each part contains a field and its terminating `delimiter` (or the newline ending the row, for
+/// the last field); delimiters inside quoted fields do not end fields. Use `csv_field` to get the
+/// contents of a field.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(size of the row + number of fields * (p.parts_count() - i))
+inline size_t split_csv_fields(
+    partitioning<const char*>& p, size_t i, char delimiter = ',', char quote = '"'
+) {
+  PRECONDITION(i < p.parts_count());
+
+  const auto [first, last] = p.part(i);
+  size_t fields = 1;
+  bool in_quotes = false;
+  const char* done = first;
+  detail::for_each_byte_of(first, last, quote, delimiter, [&](const char* c) {
+    if (*c == quote) {
+      in_quotes = !in_quotes;
+    } else if (!in_quotes) {
+      p.add_part_begin(i + fields - 1);
+      p.grow_by(i + fields - 1, static_cast<size_t>(c + 1 - done));
+      done = c + 1;
+      ++fields;
+    }
+  });
+  return fields;
+}
+
+/// Returns the contents of the CSV field in `part` (a part created by `split_csv_fields`), without
+/// its terminating delimiter or newline, and without enclosing quotes.
+///
+/// Escaped quotes (`""`) inside quoted fields are returned as they are.
+inline std::string_view
+csv_field(std::pair<const char*, const char*> part, char delimiter = ',', char quote = '"') {
+  auto [first, last] = part;
+  if (first != last && (last[-1] == delimiter || last[-1] == '\n'))
+    --last;
+  if (first != last && last[-1] == '\r')
+    --last;
+  if (last - first >= 2 && *first == quote && last[-1] == quote) {
+    ++first;
+    --last;
+  }
+  return {first, static_cast<size_t>(last - first)};
+}
+
+} // namespace positionless
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+namespace positionless::detail {
+
+/// A machine word processed as 8 bytes at once ("SIMD within a register").
+using byte_word = uint64_t;
+
+/// The number of bytes in a `byte_word`.
+inline constexpr size_t byte_word_size = sizeof(byte_word);
+
+/// `true` if bytes can be scanned word-wise, i.e., if the bit order of `byte_mask` matches the byte
+/// order in memory.
+inline constexpr bool byte_scan_supported = std::endian::native == std::endian::little;
+
+/// Returns the `byte_word_size` bytes starting at `p`.
+inline byte_word load_byte_word(const char* p) noexcept {
+  byte_word r;
+  std::memcpy(&r, p, sizeof(r));
+  return r;
+}
+
+/// Returns a mask with the high bit of each byte of `w` set iff that byte equals `c`.
+inline byte_word byte_mask(byte_word w, char c) noexcept {
+  constexpr byte_word low7 = 0x7f7f7f7f7f7f7f7full;
+  const byte_word v = w ^ (0x0101010101010101ull * static_cast<uint8_t>(c));
+  // The high bit of `t` is set for each non-zero byte of `v`, without carries between bytes.
+  const byte_word t = ((v & low7) + low7) | v;
+  return ~(t | low7);
+}
+
+/// Returns the index of the byte selected by the lowest set bit of the non-zero `mask`.
+inline size_t first_byte_in_mask(byte_word mask) noexcept {
+  return static_cast<size_t>(std::countr_zero(mask)) / 8;
+}
+
+/// Calls `f` with a pointer to each byte of [first, last) equal to `a` or `b`, in order.
+template <typename F>
+inline void for_each_byte_of(const char* first, const char* last, char a, char b, F&& f) {
+  const char* p = first;
+  if constexpr (byte_scan_supported) {
+    for (; static_cast<size_t>(last - p) >= byte_word_size; p += byte_word_size) {
+      const byte_word w = load_byte_word(p);
+      for (byte_word m = byte_mask(w, a) | byte_mask(w, b); m != 0; m &= m - 1)
+        f(p + first_byte_in_mask(m));
+    }
+  }
+  for (; p != last; ++p) {
+    if (*p == a || *p == b)
+      f(p);
+  }
+}
+
+/// Returns the number of bytes of [first, last) equal to `c`.
+inline size_t count_byte(const char* first, const char* last, char c) noexcept {
+  size_t r = 0;
+  const char* p = first;
+  if constexpr (byte_scan_supported) {
+    for (; static_cast<size_t>(last - p) >= byte_word_size; p += byte_word_size)
+      r += static_cast<size_t>(std::popcount(byte_mask(load_byte_word(p), c)));
+  }
+  for (; p != last; ++p)
+    r += *p == c;
+  return r;
+}
+
+} // namespace positionless::detail
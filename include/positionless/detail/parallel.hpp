@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace positionless::detail {
+
+/// The minimum number of elements worth processing in a task of its own.
+inline constexpr size_t min_parallel_chunk = 4096;
+
+/// Returns the number of threads to use for parallel work: the hardware concurrency, or 1 if it
+/// is unknown.
+inline size_t default_concurrency() {
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+/// Returns the number of tasks to split `n` elements into, so that each task has at least
+/// `min_chunk` elements and each thread has about two tasks.
+inline size_t parallel_tasks(size_t n, size_t min_chunk = min_parallel_chunk) {
+  return std::clamp<size_t>(n / min_chunk, 1, 2 * default_concurrency());
+}
+
+/// Calls `f(t)` for each `t` in [0, tasks), on up to `threads` threads including the calling one,
+/// and returns when all the calls have returned.
+///
+/// If calls throw, the remaining tasks are skipped and the first exception is rethrown. If a
+/// thread cannot be started, the tasks are run on the threads already started.
+///
+/// `Thread` is the type of the started threads, like `std::thread`.
+template <typename Thread = std::thread, typename F>
+inline void parallel_for(size_t tasks, F&& f, size_t threads = default_concurrency()) {
+  if (tasks == 0)
+    return;
+  threads = std::clamp<size_t>(threads, 1, tasks);
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  const auto work = [&] {
+    for (size_t t = next++; t < tasks && !failed; t = next++) {
+      try {
+        f(t);
+      } catch (...) {
+        if (!failed.exchange(true))
+          error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<Thread> workers;
+  workers.reserve(threads - 1);
+  try {
+    for (size_t k = 1; k < threads; ++k)
+      workers.emplace_back(work);
+  } catch (...) {
+    // Typically `std::system_error` for lack of resources: the started threads and the calling
+    // one share all the tasks anyway.
+  }
+  work();
+  for (auto& w : workers)
+    w.join();
+  if (error)
+    std::rethrow_exception(error);
+}
+
+} // namespace positionless::detail
@@ -1,11 +1,32 @@
 #pragma once
 
+/// The contract levels, selecting which preconditions are checked.
+///
+/// - `POSITIONLESS_CONTRACT_OFF`: no checks.
+/// - `POSITIONLESS_CONTRACT_CHEAP`: O(1) checks (`PRECONDITION`).
+/// - `POSITIONLESS_CONTRACT_FULL`: also checks whose cost grows with the size of the operation
+///   without changing its complexity, e.g. one per step of a loop (`EXPENSIVE_PRECONDITION`).
+/// - `POSITIONLESS_CONTRACT_AUDIT`: also checks that cost as much as the operation itself or more,
+///   e.g. that the inputs of a merge are sorted (`AUDIT_PRECONDITION`).
+#define POSITIONLESS_CONTRACT_OFF 0
+#define POSITIONLESS_CONTRACT_CHEAP 1
+#define POSITIONLESS_CONTRACT_FULL 2
+#define POSITIONLESS_CONTRACT_AUDIT 3
+
+/// The contract level of the program; define it before including any positionless header.
+///
+/// The level is selected per program rather than per translation unit: the checks are part of
+/// inline functions, which must have the same definition in all the translation units.
+#if !defined(POSITIONLESS_CONTRACT_LEVEL)
+#define POSITIONLESS_CONTRACT_LEVEL POSITIONLESS_CONTRACT_FULL
+#endif
+
 #if defined(NDEBUG)
 
 #include <exception>
 
-/// Assert-like precondition check that calls `std::terminate` on failure.
-#define PRECONDITION(expr)                                                                         \
+/// Assert-like check that calls `std::terminate` on failure.
+#define POSITIONLESS_CHECK(expr)                                                                   \
   do {                                                                                             \
     if (!(expr))                                                                                   \
       std::terminate();                                                                            \
@@ -13,6 +34,32 @@
 #else
 
 #include <cassert>
-#define PRECONDITION(expr) assert(expr)
+#define POSITIONLESS_CHECK(expr) assert(expr)
+
+#endif
 
-#endif
\ No newline at end of file
+/// A disabled check: `expr` is not evaluated, but the names it uses are still considered used.
+#define POSITIONLESS_UNCHECKED(expr) static_cast<void>(sizeof(!(expr)))
+
+/// Checks the O(1) precondition `expr`, if the contract level is at least cheap.
+#if POSITIONLESS_CONTRACT_LEVEL >= POSITIONLESS_CONTRACT_CHEAP
+#define PRECONDITION(expr) POSITIONLESS_CHECK(expr)
+#else
+#define PRECONDITION(expr) POSITIONLESS_UNCHECKED(expr)
+#endif
+
+/// Checks the precondition `expr`, whose total cost grows with the size of the operation, if the
+/// contract level is at least full.
+#if POSITIONLESS_CONTRACT_LEVEL >= POSITIONLESS_CONTRACT_FULL
+#define EXPENSIVE_PRECONDITION(expr) POSITIONLESS_CHECK(expr)
+#else
+#define EXPENSIVE_PRECONDITION(expr) POSITIONLESS_UNCHECKED(expr)
+#endif
+
+/// Checks the precondition `expr`, which costs as much as the operation or more, if the contract
+/// level is audit.
+#if POSITIONLESS_CONTRACT_LEVEL >= POSITIONLESS_CONTRACT_AUDIT
+#define AUDIT_PRECONDITION(expr) POSITIONLESS_CHECK(expr)
+#else
+#define AUDIT_PRECONDITION(expr) POSITIONLESS_UNCHECKED(expr)
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+/// Whether the tracing hooks of the library record events; 0 (the default) compiles them out.
+///
+/// All the translation units of a program should use the same setting, as the hooks are part of
+/// inline functions.
+#if !defined(POSITIONLESS_TRACING)
+#define POSITIONLESS_TRACING 0
+#endif
+
+#if POSITIONLESS_TRACING
+
+#include "positionless/tracing.hpp"
+
+#define POSITIONLESS_TRACE_CONCAT_IMPL(a, b) a##b
+#define POSITIONLESS_TRACE_CONCAT(a, b) POSITIONLESS_TRACE_CONCAT_IMPL(a, b)
+
+/// Records an instant event named `name`, with up to two `{"argument", value}` arguments.
+#define POSITIONLESS_TRACE_EVENT(name, ...)                                                        \
+  ::positionless::detail::record_trace_instant(name __VA_OPT__(, ) __VA_ARGS__)
+
+/// Records an event named `name`, with up to two `{"argument", value}` arguments, spanning from
+/// this statement to the end of the enclosing scope.
+#define POSITIONLESS_TRACE_SCOPE(name, ...)                                                        \
+  const ::positionless::trace_scope POSITIONLESS_TRACE_CONCAT(                                     \
+      positionless_trace_scope_, __LINE__                                                          \
+  )(name __VA_OPT__(, ) __VA_ARGS__)
+
+#else
+
+#define POSITIONLESS_TRACE_EVENT(name, ...) static_cast<void>(0)
+#define POSITIONLESS_TRACE_SCOPE(name, ...) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "positionless/algorithms.hpp"
+#include "positionless/detail/parallel.hpp"
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <version>
+
+#if defined(__cpp_lib_execution) && __cpp_lib_execution >= 201902L
+#include <execution>
+#define POSITIONLESS_HAS_STD_EXECUTION 1
+#else
+#define POSITIONLESS_HAS_STD_EXECUTION 0
+#endif
+
+namespace positionless {
+
+/// The execution policies accepted by the algorithms: those of `std::execution` when the standard
+/// library provides them, and equivalent ones otherwise (e.g. with libc++ without
+/// `-fexperimental-library`).
+///
+/// The parallel policies run the algorithms on the threads of the library, whatever the parallel
+/// backend of the standard library; the other policies run them sequentially.
+namespace execution {
+
+#if POSITIONLESS_HAS_STD_EXECUTION
+
+using std::execution::parallel_policy;
+using std::execution::parallel_unsequenced_policy;
+using std::execution::sequenced_policy;
+using std::execution::unsequenced_policy;
+
+using std::execution::par;
+using std::execution::par_unseq;
+using std::execution::seq;
+using std::execution::unseq;
+
+/// `true` if `T` is an execution policy.
+template <typename T> inline constexpr bool is_execution_policy_v = std::is_execution_policy_v<T>;
+
+#else
+
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+struct unsequenced_policy {};
+
+inline constexpr sequenced_policy seq{};
+inline constexpr parallel_policy par{};
+inline constexpr parallel_unsequenced_policy par_unseq{};
+inline constexpr unsequenced_policy unseq{};
+
+/// `true` if `T` is an execution policy.
+template <typename T>
+inline constexpr bool is_execution_policy_v =
+    std::is_same_v<T, sequenced_policy> || std::is_same_v<T, parallel_policy> ||
+    std::is_same_v<T, parallel_unsequenced_policy> || std::is_same_v<T, unsequenced_policy>;
+
+#endif
+
+/// `true` if `T`, with any reference and cv-qualifiers, is an execution policy.
+template <typename T>
+concept execution_policy = is_execution_policy_v<std::remove_cvref_t<T>>;
+
+/// `true` if `T`, with any reference and cv-qualifiers, allows running on several threads.
+template <typename T>
+inline constexpr bool is_parallel_policy_v =
+    std::is_same_v<std::remove_cvref_t<T>, parallel_policy> ||
+    std::is_same_v<std::remove_cvref_t<T>, parallel_unsequenced_policy>;
+
+} // namespace execution
+
+namespace detail {
+
+/// Merges the adjacent sorted ranges [bounds[k], bounds[k + 1]) into a single sorted range,
+/// merging pairs of ranges in parallel.
+template <std::bidirectional_iterator Iterator, typename Compare>
+inline void parallel_merge(std::vector<Iterator> bounds, Compare& comp) {
+  while (bounds.size() > 2) {
+    const size_t pairs = (bounds.size() - 1) / 2;
+    parallel_for(pairs, [&](size_t t) {
+      POSITIONLESS_TRACE_SCOPE("parallel_merge: merge pair", {"pair", t});
+      std::inplace_merge(bounds[2 * t], bounds[2 * t + 1], bounds[2 * t + 2], comp);
+    });
+    // Keep the bounds of the merged ranges, and of the last range if it was not paired.
+    size_t kept = 0;
+    for (size_t k = 0; k < bounds.size(); k += 2)
+      bounds[kept++] = bounds[k];
+    if (bounds.size() % 2 == 0)
+      bounds[kept++] = bounds.back();
+    bounds.resize(kept);
+  }
+}
+
+} // namespace detail
+
+/// Calls `swap_first(p, i, j)`; the swap is sequential under all policies.
+template <execution::execution_policy Policy, std::forward_iterator Iterator>
+inline void swap_first(Policy&&, partitioning<Iterator>& p, size_t i, size_t j) {
+  swap_first(p, i, j);
+}
+
+/// Calls `for_each_part(p, f)`, calling `f` concurrently for different parts under the parallel
+/// policies.
+template <execution::execution_policy Policy, std::forward_iterator Iterator, typename F>
+inline void for_each_part(Policy&&, const partitioning<Iterator>& p, F f) {
+  if constexpr (!execution::is_parallel_policy_v<Policy>) {
+    for_each_part(p, f);
+  } else {
+    detail::parallel_for(p.parts_count(), [&](size_t j) { f(p.part(j)); });
+  }
+}
+
+/// Returns `reduce_parts(p, init, reduce, transform)`, calling `transform` and `reduce`
+/// concurrently under the parallel policies.
+///
+/// - Precondition: `reduce` is associative
+template <
+    execution::execution_policy Policy, std::forward_iterator Iterator, typename T,
+    typename Reduce, typename Transform>
+inline T reduce_parts(
+    Policy&&, const partitioning<Iterator>& p, T init, Reduce reduce, Transform transform
+) {
+  if constexpr (!execution::is_parallel_policy_v<Policy>) {
+    return reduce_parts(p, std::move(init), reduce, transform);
+  } else {
+    const size_t parts = p.parts_count();
+    const size_t tasks = detail::parallel_tasks(parts, 1);
+    // Each task folds a contiguous sequence of parts; the results are then folded in order.
+    std::vector<std::optional<T>> folded(tasks);
+    detail::parallel_for(tasks, [&](size_t t) {
+      for (size_t j = parts * t / tasks; j < parts * (t + 1) / tasks; ++j) {
+        if (folded[t])
+          folded[t] = reduce(std::move(*folded[t]), transform(p.part(j)));
+        else
+          folded[t].emplace(transform(p.part(j)));
+      }
+    });
+    for (auto& r : folded) {
+      if (r)
+        init = reduce(std::move(init), std::move(*r));
+    }
+    return init;
+  }
+}
+
+/// Returns `split_runs(p, i, comp)`, scanning chunks of the part concurrently under the parallel
+/// policies if `Iterator` is random access.
+template <
+    execution::execution_policy Policy, std::forward_iterator Iterator,
+    typename Compare = std::less<>>
+inline size_t split_runs(Policy&&, partitioning<Iterator>& p, size_t i, Compare comp = {}) {
+  if constexpr (!execution::is_parallel_policy_v<Policy> ||
+                !std::random_access_iterator<Iterator>) {
+    return split_runs(p, i, comp);
+  } else {
+    PRECONDITION(i < p.parts_count());
+    const auto [first, last] = p.part(i);
+    const auto n = static_cast<size_t>(last - first);
+    const size_t tasks = detail::parallel_tasks(n);
+    if (tasks == 1)
+      return split_runs(p, i, comp);
+    POSITIONLESS_TRACE_SCOPE("split_runs", {"part", i}, {"tasks", tasks});
+
+    // The starts of the runs, except the first, in each chunk.
+    std::vector<std::vector<Iterator>> starts(tasks);
+    detail::parallel_for(tasks, [&](size_t t) {
+      POSITIONLESS_TRACE_SCOPE("split_runs: find run starts", {"chunk", t});
+      const Iterator chunk_last = first + static_cast<ptrdiff_t>(n * (t + 1) / tasks);
+      for (Iterator k = first + static_cast<ptrdiff_t>(std::max<size_t>(1, n * t / tasks));
+           k < chunk_last; ++k) {
+        if (comp(*k, *(k - 1)))
+          starts[t].push_back(k);
+      }
+    });
+
+    size_t total = 0;
+    for (const auto& chunk_starts : starts)
+      total += chunk_starts.size();
+    p.reserve_parts(p.parts_count() + total);
+    size_t runs = 1;
+    Iterator done = first;
+    for (const auto& chunk_starts : starts) {
+      for (const Iterator s : chunk_starts) {
+        p.add_part_begin(i + runs - 1);
+        p.grow_by(i + runs - 1, static_cast<size_t>(s - done));
+        done = s;
+        ++runs;
+      }
+    }
+    return runs;
+  }
+}
+
+/// Calls `merge_with_next(p, i, comp)`; merging two parts is sequential under all policies.
+template <
+    execution::execution_policy Policy, std::bidirectional_iterator Iterator,
+    typename Compare = std::less<>>
+inline void merge_with_next(Policy&&, partitioning<Iterator>& p, size_t i, Compare comp = {}) {
+  merge_with_next(p, i, comp);
+}
+
+/// Calls `merge_parts(p, i, runs, comp)`, merging pairs of adjacent parts concurrently under the
+/// parallel policies.
+template <
+    execution::execution_policy Policy, std::bidirectional_iterator Iterator,
+    typename Compare = std::less<>>
+inline void
+merge_parts(Policy&&, partitioning<Iterator>& p, size_t i, size_t runs, Compare comp = {}) {
+  if constexpr (!execution::is_parallel_policy_v<Policy>) {
+    merge_parts(p, i, runs, comp);
+  } else {
+    PRECONDITION(runs >= 1);
+    PRECONDITION(i + runs <= p.parts_count());
+    const Iterator first = p.part(i).first;
+    const Iterator last = p.part(i + runs - 1).second;
+    if (detail::parallel_tasks(static_cast<size_t>(std::distance(first, last))) == 1) {
+      merge_parts(p, i, runs, comp);
+      return;
+    }
+    POSITIONLESS_TRACE_SCOPE("merge_parts", {"part", i}, {"runs", runs});
+
+    std::vector<Iterator> bounds;
+    bounds.reserve(runs + 1);
+    for (size_t k = 0; k < runs; ++k) {
+      AUDIT_PRECONDITION(std::is_sorted(p.part(i + k).first, p.part(i + k).second, comp));
+      bounds.push_back(p.part(i + k).first);
+    }
+    bounds.push_back(last);
+    detail::parallel_merge(std::move(bounds), comp);
+    // Removing the last parts first avoids moving the boundaries of parts about to be removed.
+    for (size_t k = i + runs - 1; k > i; --k)
+      p.remove_part(k);
+  }
+}
+
+/// Returns `sort_part(p, i, comp)`, sorting chunks of the part concurrently and then merging them
+/// in parallel under the parallel policies if `Iterator` is random access.
+///
+/// The sort is stable. The returned number of runs is the sum of those of the chunks.
+template <
+    execution::execution_policy Policy, std::bidirectional_iterator Iterator,
+    typename Compare = std::less<>>
+inline size_t sort_part(Policy&&, partitioning<Iterator>& p, size_t i, Compare comp = {}) {
+  if constexpr (!execution::is_parallel_policy_v<Policy> ||
+                !std::random_access_iterator<Iterator>) {
+    return sort_part(p, i, comp);
+  } else {
+    PRECONDITION(i < p.parts_count());
+    const auto [first, last] = p.part(i);
+    const auto n = static_cast<size_t>(last - first);
+    const size_t tasks = detail::parallel_tasks(n);
+    if (tasks == 1)
+      return sort_part(p, i, comp);
+    POSITIONLESS_TRACE_SCOPE("sort_part", {"part", i}, {"tasks", tasks});
+
+    std::vector<Iterator> bounds(tasks + 1);
+    for (size_t t = 0; t <= tasks; ++t)
+      bounds[t] = first + static_cast<ptrdiff_t>(n * t / tasks);
+    std::vector<size_t> runs(tasks);
+    detail::parallel_for(tasks, [&](size_t t) {
+      partitioning<Iterator> chunk(bounds[t], bounds[t + 1]);
+      runs[t] = sort_part(chunk, 0, comp);
+    });
+    detail::parallel_merge(std::move(bounds), comp);
+    return std::accumulate(runs.begin(), runs.end(), size_t{0});
+  }
+}
+
+} // namespace positionless
@@ -0,0 +1,200 @@
+#pragma once
+
+#include "positionless/algorithms.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/mapped_file.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/scatter_io.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace positionless {
+
+/// The shape of the work done by an `external_sort`.
+struct external_sort_stats {
+  /// The number of elements of each chunk sorted in memory.
+  std::vector<size_t> chunk_sizes;
+  /// The number of sorted runs merged in memory for each chunk (see `sort_part`).
+  std::vector<size_t> chunk_runs;
+};
+
+namespace detail {
+
+/// A set of temporary files, removed on destruction.
+class spill_files {
+public:
+  spill_files() = default;
+  spill_files(const spill_files&) = delete;
+  spill_files& operator=(const spill_files&) = delete;
+
+  ~spill_files() {
+    std::error_code ignored;
+    for (const auto& path : paths_)
+      std::filesystem::remove(path, ignored);
+  }
+
+  /// Creates a new empty temporary file, returning a descriptor open for writing.
+  ///
+  /// Throws `std::system_error` on failure.
+  int create() {
+    auto name = (std::filesystem::temp_directory_path() / "positionless_run_XXXXXX").string();
+    const int fd = ::mkstemp(name.data());
+    if (fd < 0)
+      throw std::system_error(errno, std::generic_category(), "external_sort: mkstemp");
+    paths_.emplace_back(std::move(name));
+    return fd;
+  }
+
+  /// Returns the paths of the files created so far.
+  [[nodiscard]]
+  const std::vector<std::filesystem::path>& paths() const noexcept {
+    return paths_;
+  }
+
+private:
+  /// The paths of the created files.
+  std::vector<std::filesystem::path> paths_;
+};
+
+/// Writes the `n` elements starting at `data` to `out`, as raw bytes.
+template <typename T> inline void write_elements(std::ofstream& out, const T* data, size_t n) {
+  out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+/// Merges the sorted runs of `T`s stored in the files at `runs` into `out`.
+template <typename T, typename Compare>
+inline void
+merge_runs(const std::vector<std::filesystem::path>& runs, std::ofstream& out, Compare comp) {
+  std::vector<mapped_file_partitioning> mapped;
+  mapped.reserve(runs.size());
+  for (const auto& path : runs)
+    mapped.emplace_back(path);
+
+  // The next element of each run; `cursors[r]` is the position of the element after it.
+  struct head {
+    T value;
+    size_t run;
+  };
+  std::vector<const char*> cursors(runs.size());
+  const auto heap_order = [&](const head& a, const head& b) { return comp(b.value, a.value); };
+  std::priority_queue<head, std::vector<head>, decltype(heap_order)> heads(heap_order);
+  const auto push_next = [&](size_t r) {
+    if (cursors[r] == mapped[r].part(0).second)
+      return;
+    head h{{}, r};
+    std::memcpy(&h.value, cursors[r], sizeof(T));
+    cursors[r] += sizeof(T);
+    heads.push(h);
+  };
+  for (size_t r = 0; r < runs.size(); ++r) {
+    cursors[r] = mapped[r].part(0).first;
+    push_next(r);
+  }
+
+  std::vector<T> buffer;
+  buffer.reserve(std::max<size_t>(1, (size_t{1} << 16) / sizeof(T)));
+  while (!heads.empty()) {
+    const head h = heads.top();
+    heads.pop();
+    buffer.push_back(h.value);
+    if (buffer.size() == buffer.capacity()) {
+      write_elements(out, buffer.data(), buffer.size());
+      buffer.clear();
+    }
+    push_next(h.run);
+  }
+  write_elements(out, buffer.data(), buffer.size());
+}
+
+} // namespace detail
+
+/// Sorts the `T`s stored in the file at `input` with respect to `comp`, writing them to the file
+/// at `output`, while holding at most about `memory_budget` bytes of elements in memory.
+///
+/// The input is read in chunks that fit `memory_budget`; each chunk is sorted in memory with
+/// `sort_part`, a merge sort over a partitioning of the chunk into its sorted runs, and spilled to
+/// a temporary file. The spilled runs are then memory mapped and merged into `output`.
+/// Returns the size and number of merged runs of each chunk.
+///
+/// Throws `std::runtime_error` if the size of the input file is not a multiple of `sizeof(T)`,
+/// and `std::system_error` or `std::ios_base::failure` on I/O errors.
+template <typename T, typename Compare = std::less<>>
+  requires std::is_trivially_copyable_v<T>
+inline external_sort_stats external_sort(
+    const std::filesystem::path& input,
+    const std::filesystem::path& output,
+    size_t memory_budget,
+    Compare comp = {}
+) {
+  // File streams do not report why they failed to open.
+  std::ifstream in(input, std::ios::binary);
+  if (!in)
+    throw std::ios_base::failure("external_sort: cannot open " + input.string());
+  std::ofstream out(output, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::ios_base::failure("external_sort: cannot open " + output.string());
+  out.exceptions(std::ios::badbit | std::ios::failbit);
+
+  external_sort_stats stats;
+  detail::spill_files spills;
+  std::vector<T> chunk(std::max<size_t>(1, memory_budget / sizeof(T)));
+  for (;;) {
+    const auto capacity = static_cast<std::streamsize>(chunk.size() * sizeof(T));
+    in.read(reinterpret_cast<char*>(chunk.data()), capacity);
+    if (in.bad())
+      throw std::ios_base::failure("external_sort: cannot read " + input.string());
+    const auto bytes = static_cast<size_t>(in.gcount());
+    if (bytes % sizeof(T) != 0)
+      throw std::runtime_error(
+          "external_sort: the size of " + input.string() + " is not a multiple of the element size"
+      );
+    if (bytes == 0)
+      break;
+
+    partitioning<typename std::vector<T>::iterator> p(
+        chunk.begin(), chunk.begin() + static_cast<std::ptrdiff_t>(bytes / sizeof(T))
+    );
+    stats.chunk_sizes.push_back(bytes / sizeof(T));
+    POSITIONLESS_TRACE_SCOPE("external_sort: chunk", {"chunk", stats.chunk_sizes.size() - 1});
+    stats.chunk_runs.push_back(sort_part(p, 0, comp));
+
+    // A single chunk needs no merging.
+    if (bytes < chunk.size() * sizeof(T) && spills.paths().empty()) {
+      detail::write_elements(out, chunk.data(), bytes / sizeof(T));
+      return stats;
+    }
+
+    const int fd = spills.create();
+    try {
+      writev_parts(p, fd);
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd);
+    if (bytes < chunk.size() * sizeof(T))
+      break;
+  }
+
+  // Release the chunk memory before mapping the runs.
+  std::vector<T>().swap(chunk);
+  POSITIONLESS_TRACE_SCOPE("external_sort: merge", {"runs", spills.paths().size()});
+  detail::merge_runs<T>(spills.paths(), out, comp);
+  return stats;
+}
+
+} // namespace positionless
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace positionless {
+
+/// The number of operations performed through instrumented iterators and predicates.
+struct operation_counts {
+  /// The number of `++` applied to iterators.
+  size_t increments{0};
+  /// The number of `--` applied to iterators.
+  size_t decrements{0};
+  /// The number of random-access moves (`+=`, `-=`, `+`, `-` with an offset, and `[]`).
+  size_t jumps{0};
+  /// The number of distances computed by subtracting iterators.
+  size_t distances{0};
+  /// The number of elements accessed through iterators (`*`, `->` and `[]`).
+  size_t dereferences{0};
+  /// The number of calls of counting predicates.
+  size_t comparisons{0};
+  /// The number of elements swapped through `std::ranges::iter_swap`.
+  size_t swaps{0};
+  /// The number of elements moved out through `std::ranges::iter_move`.
+  size_t moves{0};
+
+  /// Returns the sum of all the counts.
+  size_t total() const {
+    return increments + decrements + jumps + distances + dereferences + comparisons + swaps + moves;
+  }
+
+  /// Sets all the counts to 0.
+  void reset() { *this = operation_counts{}; }
+
+  /// Returns a human-readable report of the counts, one per line.
+  std::string report() const {
+    std::ostringstream os;
+    os << "increments:   " << increments << '\n'
+       << "decrements:   " << decrements << '\n'
+       << "jumps:        " << jumps << '\n'
+       << "distances:    " << distances << '\n'
+       << "dereferences: " << dereferences << '\n'
+       << "comparisons:  " << comparisons << '\n'
+       << "swaps:        " << swaps << '\n'
+       << "moves:        " << moves << '\n';
+    return os.str();
+  }
+
+  /// Adds the counts of `other` to `this`.
+  operation_counts& operator+=(const operation_counts& other) {
+    increments += other.increments;
+    decrements += other.decrements;
+    jumps += other.jumps;
+    distances += other.distances;
+    dereferences += other.dereferences;
+    comparisons += other.comparisons;
+    swaps += other.swaps;
+    moves += other.moves;
+    return *this;
+  }
+
+  /// Returns the counts of the operations done after `before` was taken, up to `this`.
+  operation_counts operator-(const operation_counts& before) const {
+    operation_counts r;
+    r.increments = increments - before.increments;
+    r.decrements = decrements - before.decrements;
+    r.jumps = jumps - before.jumps;
+    r.distances = distances - before.distances;
+    r.dereferences = dereferences - before.dereferences;
+    r.comparisons = comparisons - before.comparisons;
+    r.swaps = swaps - before.swaps;
+    r.moves = moves - before.moves;
+    return r;
+  }
+
+  bool operator==(const operation_counts&) const = default;
+
+  /// Writes the report of `counts` to `os`.
+  friend std::ostream& operator<<(std::ostream& os, const operation_counts& counts) {
+    return os << counts.report();
+  }
+};
+
+/// An iterator adaptor over `Iterator` that records the operations performed on it in an
+/// `operation_counts` object shared by all its copies.
+///
+/// The adaptor models the same iterator concepts as `Iterator`, except that contiguous iterators
+/// are only random access ones, so that algorithms cannot bypass the counted operations through
+/// pointers; otherwise, `partitioning` and the algorithms over it pick the same code paths as for
+/// the underlying iterator. Operations on default-constructed adaptors are not counted.
+///
+/// Swaps and moves are only counted when done through the `std::ranges::iter_swap` and
+/// `std::ranges::iter_move` customization points; algorithms that assign through references are
+/// accounted for by their dereferences.
+template <std::input_iterator Iterator> class instrumented_iterator {
+public:
+  using iterator_type = Iterator;
+  using value_type = std::iter_value_t<Iterator>;
+  using difference_type = std::iter_difference_t<Iterator>;
+  using reference = std::iter_reference_t<Iterator>;
+  using iterator_category = typename std::iterator_traits<Iterator>::iterator_category;
+  using iterator_concept = std::conditional_t<
+      std::contiguous_iterator<Iterator>, std::random_access_iterator_tag, iterator_category>;
+
+  /// An instance that does not count operations.
+  instrumented_iterator() = default;
+
+  /// An instance wrapping `base`, recording its operations in `counts`.
+  instrumented_iterator(Iterator base, operation_counts& counts)
+      : base_(std::move(base)), counts_(std::addressof(counts)) {}
+
+  /// Returns the wrapped iterator.
+  const Iterator& base() const { return base_; }
+
+  /// Returns the counts in which the operations are recorded, or `nullptr` if not counting.
+  operation_counts* counts() const { return counts_; }
+
+  reference operator*() const {
+    count(&operation_counts::dereferences);
+    return *base_;
+  }
+
+  auto operator->() const
+    requires std::is_reference_v<reference>
+  {
+    count(&operation_counts::dereferences);
+    return std::addressof(*base_);
+  }
+
+  instrumented_iterator& operator++() {
+    count(&operation_counts::increments);
+    ++base_;
+    return *this;
+  }
+
+  instrumented_iterator operator++(int) {
+    instrumented_iterator r = *this;
+    ++*this;
+    return r;
+  }
+
+  instrumented_iterator& operator--()
+    requires std::bidirectional_iterator<Iterator>
+  {
+    count(&operation_counts::decrements);
+    --base_;
+    return *this;
+  }
+
+  instrumented_iterator operator--(int)
+    requires std::bidirectional_iterator<Iterator>
+  {
+    instrumented_iterator r = *this;
+    --*this;
+    return r;
+  }
+
+  instrumented_iterator& operator+=(difference_type n)
+    requires std::random_access_iterator<Iterator>
+  {
+    count(&operation_counts::jumps);
+    base_ += n;
+    return *this;
+  }
+
+  instrumented_iterator& operator-=(difference_type n)
+    requires std::random_access_iterator<Iterator>
+  {
+    count(&operation_counts::jumps);
+    base_ -= n;
+    return *this;
+  }
+
+  reference operator[](difference_type n) const
+    requires std::random_access_iterator<Iterator>
+  {
+    count(&operation_counts::jumps);
+    count(&operation_counts::dereferences);
+    return base_[n];
+  }
+
+  friend instrumented_iterator operator+(instrumented_iterator i, difference_type n)
+    requires std::random_access_iterator<Iterator>
+  {
+    return i += n;
+  }
+
+  friend instrumented_iterator operator+(difference_type n, instrumented_iterator i)
+    requires std::random_access_iterator<Iterator>
+  {
+    return i += n;
+  }
+
+  friend instrumented_iterator operator-(instrumented_iterator i, difference_type n)
+    requires std::random_access_iterator<Iterator>
+  {
+    return i -= n;
+  }
+
+  friend difference_type operator-(const instrumented_iterator& a, const instrumented_iterator& b)
+    requires std::sized_sentinel_for<Iterator, Iterator>
+  {
+    a.count(&operation_counts::distances);
+    return a.base_ - b.base_;
+  }
+
+  friend bool operator==(const instrumented_iterator& a, const instrumented_iterator& b)
+    requires std::equality_comparable<Iterator>
+  {
+    return a.base_ == b.base_;
+  }
+
+  friend auto operator<=>(const instrumented_iterator& a, const instrumented_iterator& b)
+    requires std::random_access_iterator<Iterator>
+  {
+    return a.base_ <=> b.base_;
+  }
+
+  friend decltype(auto) iter_move(const instrumented_iterator& i) noexcept(
+      noexcept(std::ranges::iter_move(std::declval<const Iterator&>()))
+  ) {
+    i.count(&operation_counts::moves);
+    return std::ranges::iter_move(i.base_);
+  }
+
+  friend void iter_swap(const instrumented_iterator& a, const instrumented_iterator& b)
+    requires std::indirectly_swappable<Iterator>
+  {
+    a.count(&operation_counts::swaps);
+    std::ranges::iter_swap(a.base_, b.base_);
+  }
+
+private:
+  /// Increments the count `field` of `counts_`, if counting.
+  void count(size_t operation_counts::* field) const noexcept {
+    if (counts_ != nullptr)
+      ++(counts_->*field);
+  }
+
+  /// The wrapped iterator.
+  Iterator base_{};
+  /// The counts in which the operations are recorded, or `nullptr` if not counting.
+  operation_counts* counts_{nullptr};
+};
+
+/// Returns an adaptor over `base` recording its operations in `counts`.
+template <std::input_iterator Iterator>
+inline instrumented_iterator<Iterator> make_instrumented(Iterator base, operation_counts& counts) {
+  return instrumented_iterator<Iterator>(std::move(base), counts);
+}
+
+/// A wrapper of a comparator or predicate `F` that counts its calls as comparisons.
+template <typename F> class counting_predicate {
+public:
+  /// An instance wrapping `f`, recording its calls in `counts`.
+  counting_predicate(operation_counts& counts, F f = {})
+      : f_(std::move(f)), counts_(std::addressof(counts)) {}
+
+  /// Calls the wrapped predicate with `args`.
+  template <typename... Args>
+    requires std::predicate<const F&, Args...>
+  bool operator()(Args&&... args) const {
+    ++counts_->comparisons;
+    return std::invoke(f_, std::forward<Args>(args)...);
+  }
+
+private:
+  /// The wrapped predicate.
+  F f_;
+  /// The counts in which the calls are recorded.
+  operation_counts* counts_;
+};
+
+/// Returns a wrapper of `f` counting its calls in `counts`.
+template <typename F>
+inline counting_predicate<F> make_counting_predicate(operation_counts& counts, F f) {
+  return counting_predicate<F>(counts, std::move(f));
+}
+
+} // namespace positionless
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "positionless/partitioning.hpp"
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+
+namespace positionless {
+
+namespace detail {
+
+/// The bytes identifying a serialized layout, followed by the format version.
+inline constexpr std::array<char, 5> layout_magic{'P', 'L', 'A', 'Y', 1};
+
+/// A running FNV-1a checksum of the bytes of a serialized layout.
+class layout_checksum {
+public:
+  /// Adds `c` to the checksummed bytes.
+  void add(char c) noexcept {
+    value_ = (value_ ^ static_cast<uint8_t>(c)) * 16777619u;
+  }
+
+  /// Returns the checksum of the bytes added so far.
+  [[nodiscard]]
+  uint32_t value() const noexcept {
+    return value_;
+  }
+
+private:
+  /// The current checksum.
+  uint32_t value_{2166136261u};
+};
+
+/// Writes the byte `c` to `out`, adding it to `checksum`.
+inline void write_layout_byte(std::ostream& out, layout_checksum& checksum, char c) {
+  checksum.add(c);
+  out.put(c);
+}
+
+/// Writes `x` to `out` as a LEB128 varint, adding its bytes to `checksum`.
+inline void write_layout_varint(std::ostream& out, layout_checksum& checksum, uint64_t x) {
+  while (x >= 0x80) {
+    write_layout_byte(out, checksum, static_cast<char>((x & 0x7f) | 0x80));
+    x >>= 7;
+  }
+  write_layout_byte(out, checksum, static_cast<char>(x));
+}
+
+/// Reads a byte from `in`, adding it to `checksum`.
+///
+/// Throws `std::runtime_error` if `in` has no more bytes.
+inline char read_layout_byte(std::istream& in, layout_checksum& checksum) {
+  const auto c = in.get();
+  if (c == std::istream::traits_type::eof())
+    throw std::runtime_error("load_layout: truncated layout");
+  checksum.add(static_cast<char>(c));
+  return static_cast<char>(c);
+}
+
+/// Reads a LEB128 varint from `in`, adding its bytes to `checksum`.
+///
+/// Throws `std::runtime_error` if `in` does not contain a valid varint.
+inline uint64_t read_layout_varint(std::istream& in, layout_checksum& checksum) {
+  uint64_t r = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    const auto byte = static_cast<uint8_t>(read_layout_byte(in, checksum));
+    r |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return r;
+  }
+  throw std::runtime_error("load_layout: malformed varint");
+}
+
+} // namespace detail
+
+/// Writes the layout of `p` (its part sizes) to `out`, in a compact binary format.
+///
+/// The layout is written as the number of parts, the total size, and the sizes of all but the last
+/// part, all as varints, followed by a checksum. Only the boundaries are written, not the
+/// elements; the layout can be restored with `load_layout` over the same data.
+///
+/// - Complexity: O(parts_count())
+template <std::random_access_iterator Iterator>
+inline void save_layout(const partitioning<Iterator>& p, std::ostream& out) {
+  detail::layout_checksum checksum;
+  for (char c : detail::layout_magic)
+    detail::write_layout_byte(out, checksum, c);
+
+  const size_t k = p.parts_count();
+  const auto begin = p.part(0).first;
+  const auto end = p.part(k - 1).second;
+  detail::write_layout_varint(out, checksum, k);
+  detail::write_layout_varint(out, checksum, static_cast<uint64_t>(end - begin));
+  for (size_t i = 0; i + 1 < k; ++i)
+    detail::write_layout_varint(out, checksum, p.part_size(i));
+
+  const uint32_t sum = checksum.value();
+  for (unsigned shift = 0; shift < 32; shift += 8)
+    out.put(static_cast<char>((sum >> shift) & 0xff));
+}
+
+/// Returns a partitioning of [begin, end) with the layout read from `in`, as written by
+/// `save_layout` for a partitioning of the same range.
+///
+/// Throws `std::runtime_error` if `in` does not contain a valid layout for a range of the size of
+/// [begin, end).
+///
+/// - Complexity: O(number of parts)
+template <std::random_access_iterator Iterator>
+inline partitioning<Iterator> load_layout(Iterator begin, Iterator end, std::istream& in) {
+  detail::layout_checksum checksum;
+  for (char c : detail::layout_magic) {
+    if (detail::read_layout_byte(in, checksum) != c)
+      throw std::runtime_error("load_layout: not a layout, or unsupported version");
+  }
+
+  const uint64_t k = detail::read_layout_varint(in, checksum);
+  const uint64_t n = detail::read_layout_varint(in, checksum);
+  if (k == 0)
+    throw std::runtime_error("load_layout: invalid parts count");
+  if (n != static_cast<uint64_t>(end - begin))
+    throw std::runtime_error("load_layout: layout does not match the size of the range");
+
+  partitioning<Iterator> r(begin, end);
+  uint64_t remaining = n;
+  for (uint64_t i = 0; i + 1 < k; ++i) {
+    const uint64_t size = detail::read_layout_varint(in, checksum);
+    if (size > remaining)
+      throw std::runtime_error("load_layout: part sizes exceed the size of the range");
+    r.add_part_begin(r.parts_count() - 1);
+    r.grow_by(r.parts_count() - 2, size);
+    remaining -= size;
+  }
+
+  const uint32_t expected = checksum.value();
+  uint32_t sum = 0;
+  for (unsigned shift = 0; shift < 32; shift += 8)
+    sum |= static_cast<uint32_t>(static_cast<uint8_t>(detail::read_layout_byte(in, checksum)))
+           << shift;
+  if (sum != expected)
+    throw std::runtime_error("load_layout: checksum mismatch");
+
+  return r;
+}
+
+} // namespace positionless
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <utility>
+#include <vector>
+
+namespace positionless {
+
+/// A partitioning over the elements of a `std::list` of type `List`.
+template <typename List> using list_partitioning = partitioning<typename List::iterator>;
+
+namespace detail {
+
+/// Makes `position` the beginning of the `i`th part of `p`, and of the empty parts before it,
+/// after the node at its former beginning was relinked.
+template <std::forward_iterator Iterator>
+inline void reposition_part_begin(partitioning<Iterator>& p, size_t i, Iterator position) {
+  const Iterator old = p.part(i).first;
+  for (size_t m = i + 1; m-- > 0 && p.part(m).first == old;)
+    partitioning_access::set_part_begin(p, m, position);
+}
+
+} // namespace detail
+
+// The algorithms below relink the nodes of a `std::list` with `splice` instead of swapping or
+// moving elements: elements never move in memory, and their iterators stay valid. For `std::list`
+// partitionings, they replace the algorithms of `positionless/algorithms.hpp` when elements are
+// expensive to move. `std::forward_list` is not supported: relinking a part needs the node before
+// it, which its partitionings do not store.
+
+/// Reorders the elements of the `i`th part of `p`, over `l`, so that those satisfying `pred` come
+/// first, and splits the part after them, making the others the new part `i + 1`.
+///
+/// The partition is stable. Elements are relinked rather than moved. If `pred` throws, the part
+/// is not split and holds its elements in an unspecified order.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(part_size(i)) calls of `pred`, plus O(p.parts_count() - i)
+template <typename T, typename Allocator, typename Predicate>
+inline void splice_partition(
+    std::list<T, Allocator>& l, list_partitioning<std::list<T, Allocator>>& p, size_t i,
+    Predicate pred
+) {
+  using iterator = typename std::list<T, Allocator>::iterator;
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("splice_partition", {"part", i});
+
+  const auto [first, last] = p.part(i);
+  // The rejected elements are relinked, in order, at the end of the part; the traversal stops at
+  // the first of them, or at `last` if the last element examined was rejected in place.
+  iterator satisfying_begin = last;
+  iterator rejected_begin = last;
+  iterator k = first;
+  try {
+    while (k != rejected_begin && k != last) {
+      const iterator next = std::next(k);
+      if (pred(std::as_const(*k))) {
+        if (satisfying_begin == last)
+          satisfying_begin = k;
+      } else {
+        l.splice(last, l, k);
+        if (rejected_begin == last)
+          rejected_begin = k;
+      }
+      k = next;
+    }
+  } catch (...) {
+    // The part is [satisfying elements, unexamined elements, rejected elements).
+    detail::reposition_part_begin(p, i, satisfying_begin == last ? k : satisfying_begin);
+    throw;
+  }
+  if (satisfying_begin == last)
+    satisfying_begin = rejected_begin;
+
+  detail::reposition_part_begin(p, i, satisfying_begin);
+  p.add_part_end(i);
+  detail::partitioning_access::set_part_begin(p, i + 1, rejected_begin);
+}
+
+/// Merges the sorted parts `i` and `i + 1` of `p`, over `l`, into a single sorted part `i`.
+///
+/// The merge is stable. Elements are relinked rather than moved, and no memory is allocated. If
+/// `comp` throws, parts `i` and `i + 1` still become a single part `i`, holding their elements in
+/// an unspecified order.
+///
+/// - Precondition: `i + 1 < p.parts_count()`
+/// - Precondition: parts `i` and `i + 1` are sorted with respect to `comp`
+/// - Complexity: O(n) comparisons, where `n` is the size of both parts.
+template <typename T, typename Allocator, typename Compare = std::less<>>
+inline void splice_merge_with_next(
+    std::list<T, Allocator>& l, list_partitioning<std::list<T, Allocator>>& p, size_t i,
+    Compare comp = {}
+) {
+  using iterator = typename std::list<T, Allocator>::iterator;
+  PRECONDITION(i + 1 < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("splice_merge_with_next", {"part", i});
+
+  iterator k = p.part(i).first;
+  iterator middle = p.part(i + 1).first;
+  const iterator last = p.part(i + 1).second;
+  AUDIT_PRECONDITION(std::is_sorted(k, middle, comp));
+  AUDIT_PRECONDITION(std::is_sorted(middle, last, comp));
+
+  // The first node of the merged part: that of part `i`, unless a run is relinked before it.
+  const iterator first = k;
+  iterator begin = k;
+  // Each run of elements of part `i + 1` smaller than the next element of part `i` is relinked
+  // before it.
+  try {
+    while (k != middle && middle != last) {
+      if (comp(*middle, *k)) {
+        iterator run_end = std::next(middle);
+        while (run_end != last && comp(*run_end, *k))
+          ++run_end;
+        l.splice(k, l, middle, run_end);
+        if (k == first)
+          begin = middle;
+        middle = run_end;
+      } else {
+        ++k;
+      }
+    }
+  } catch (...) {
+    p.remove_part(i + 1);
+    detail::reposition_part_begin(p, i, begin);
+    throw;
+  }
+  p.remove_part(i + 1);
+  detail::reposition_part_begin(p, i, begin);
+}
+
+/// Sorts the elements of the `i`th part of `p`, over `l`, with respect to `comp`.
+///
+/// The sort is stable. Elements are relinked rather than moved, using `std::list::sort`. If
+/// `comp` throws, the part holds its elements in an unspecified order.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(n log n) comparisons, where `n` is the size of the part.
+template <typename T, typename Allocator, typename Compare = std::less<>>
+inline void splice_sort_part(
+    std::list<T, Allocator>& l, list_partitioning<std::list<T, Allocator>>& p, size_t i,
+    Compare comp = {}
+) {
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("splice_sort_part", {"part", i});
+
+  const auto [first, last] = p.part(i);
+  if (first == last)
+    return;
+  std::list<T, Allocator> sorted(l.get_allocator());
+  sorted.splice(sorted.begin(), l, first, last);
+  try {
+    sorted.sort(comp);
+  } catch (...) {
+    // `sorted` still holds the elements, which are relinked in place before they are destroyed.
+    const auto begin = sorted.begin();
+    l.splice(last, sorted);
+    detail::reposition_part_begin(p, i, begin);
+    throw;
+  }
+  const auto begin = sorted.begin();
+  l.splice(last, sorted);
+  detail::reposition_part_begin(p, i, begin);
+}
+
+/// Moves the `i`th part of `p`, over `l`, so that it becomes the `j`th part, the parts in between
+/// shifting by one.
+///
+/// Elements are relinked rather than moved: moving the elements takes constant time, and the
+/// boundaries are updated in O(|i - j|) plus the number of empty parts before the moved ones.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Precondition: `j < p.parts_count()`
+template <typename T, typename Allocator>
+inline void splice_part(
+    std::list<T, Allocator>& l, list_partitioning<std::list<T, Allocator>>& p, size_t i, size_t j
+) {
+  using iterator = typename std::list<T, Allocator>::iterator;
+  PRECONDITION(i < p.parts_count());
+  PRECONDITION(j < p.parts_count());
+  if (i == j)
+    return;
+  POSITIONLESS_TRACE_SCOPE("splice_part", {"from", i}, {"to", j});
+
+  const size_t low = std::min(i, j);
+  const size_t high = std::max(i, j);
+  // The parts [low, high], in their new order, as (non-empty, first node) pairs.
+  std::vector<std::pair<bool, iterator>> moved;
+  moved.reserve(high - low + 1);
+  for (size_t m = low; m <= high; ++m)
+    moved.emplace_back(!p.is_part_empty(m), p.part(m).first);
+  if (i < j)
+    std::rotate(moved.begin(), moved.begin() + 1, moved.end());
+  else
+    std::rotate(moved.begin(), moved.end() - 1, moved.end());
+
+  const auto [first, last] = p.part(i);
+  // The nodes already are in place if the parts they cross are all empty.
+  const iterator position = i < j ? p.part(j).second : p.part(j).first;
+  if (position != first && position != last)
+    l.splice(position, l, first, last);
+
+  // Each part begins at the first node of the first non-empty part at or after it.
+  iterator next = p.part(high).second;
+  const iterator old_low_begin = p.part(low).first;
+  for (size_t m = high + 1; m-- > low;) {
+    if (moved[m - low].first)
+      next = moved[m - low].second;
+    detail::partitioning_access::set_part_begin(p, m, next);
+  }
+  for (size_t m = low; m-- > 0 && p.part(m).first == old_low_begin;)
+    detail::partitioning_access::set_part_begin(p, m, next);
+}
+
+} // namespace positionless
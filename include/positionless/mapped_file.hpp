@@ -0,0 +1,127 @@
+#pragma once
+
+#include "positionless/partitioning.hpp"
+
+#include <cerrno>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace positionless {
+
+namespace detail {
+
+/// A read-only memory mapping of a whole file.
+class file_mapping {
+public:
+  /// An instance mapping the contents of the file at `path`.
+  ///
+  /// Throws `std::system_error` if the file cannot be opened or mapped.
+  explicit file_mapping(const std::filesystem::path& path);
+
+  file_mapping(const file_mapping&) = delete;
+  file_mapping& operator=(const file_mapping&) = delete;
+
+  file_mapping(file_mapping&& other) noexcept;
+  file_mapping& operator=(file_mapping&& other) noexcept;
+
+  ~file_mapping();
+
+  /// Returns a pointer to the first byte of the mapped file.
+  [[nodiscard]]
+  const char* data() const noexcept {
+    return data_;
+  }
+
+  /// Returns the number of mapped bytes.
+  [[nodiscard]]
+  size_t size() const noexcept {
+    return size_;
+  }
+
+private:
+  /// The start of the mapping; `nullptr` for empty files.
+  const char* data_{nullptr};
+  /// The length of the mapping.
+  size_t size_{0};
+};
+
+} // namespace detail
+
+/// A read-only view of a whole file, as a partitioning of its bytes.
+///
+/// The file is memory mapped for the lifetime of the instance, so that its parts can be processed
+/// (e.g., in parallel) without first reading the file into memory.
+///
+/// - Invariant: parts_count() >= 1
+class mapped_file_partitioning : private detail::file_mapping, public partitioning<const char*> {
+public:
+  /// An instance mapping the file at `path`, having just one part covering all its bytes.
+  ///
+  /// Throws `std::system_error` if the file cannot be opened or mapped.
+  explicit mapped_file_partitioning(const std::filesystem::path& path)
+      : detail::file_mapping(path), partitioning<const char*>(data(), data() + size()) {}
+
+  /// Returns the number of bytes in the file.
+  [[nodiscard]]
+  size_t file_size() const noexcept {
+    return file_mapping::size();
+  }
+};
+
+// Inline definitions
+
+inline detail::file_mapping::file_mapping(const std::filesystem::path& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    const int error = errno;
+    throw std::system_error(error, std::generic_category(), "cannot open " + path.string());
+  }
+
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    const int error = errno;
+    ::close(fd);
+    throw std::system_error(error, std::generic_category(), "cannot stat " + path.string());
+  }
+
+  size_ = static_cast<size_t>(st.st_size);
+  if (size_ != 0) {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), "cannot map " + path.string());
+    }
+    // The whole file is typically scanned front to back.
+    ::madvise(addr, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(addr);
+  }
+  // The mapping stays valid after closing the descriptor.
+  ::close(fd);
+}
+
+inline detail::file_mapping::file_mapping(file_mapping&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+inline detail::file_mapping& detail::file_mapping::operator=(file_mapping&& other) noexcept {
+  if (this != &other) {
+    if (data_ != nullptr)
+      ::munmap(const_cast<char*>(data_), size_);
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+inline detail::file_mapping::~file_mapping() {
+  if (data_ != nullptr)
+    ::munmap(const_cast<char*>(data_), size_);
+}
+
+} // namespace positionless
@@ -1,14 +1,68 @@
 #pragma once
 
 #include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
 
 #include <concepts>
+#include <cstddef>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace positionless {
 
+namespace detail {
+
+/// Moves `boundary` forward by `n` elements.
+///
+/// - Precondition: `std::distance(boundary, limit) >= n`
+/// - Complexity: O(n) for forward iterators, O(1) for random access iterators
+template <std::forward_iterator Iterator>
+inline void advance_boundary(Iterator& boundary, const Iterator& limit, size_t n) {
+  if constexpr (std::random_access_iterator<Iterator>) {
+    // For random access iterators, we can check size and advance in O(1)
+    PRECONDITION(static_cast<size_t>(std::distance(boundary, limit)) >= n);
+    boundary += n;
+  } else {
+    // For forward iterators, we need to check and advance step by step
+    for (size_t k = 0; k < n; ++k) {
+      EXPENSIVE_PRECONDITION(boundary != limit);
+      ++boundary;
+    }
+  }
+}
+
+/// Moves `boundary` back by `n` elements.
+///
+/// - Precondition: `std::distance(limit, boundary) >= n`
+/// - Complexity: O(n) for bidirectional iterators, O(1) for random access iterators
+template <std::bidirectional_iterator Iterator>
+inline void retreat_boundary(Iterator& boundary, const Iterator& limit, size_t n) {
+  if constexpr (std::random_access_iterator<Iterator>) {
+    // For random access iterators, we can check size and advance in O(1)
+    PRECONDITION(static_cast<size_t>(std::distance(limit, boundary)) >= n);
+    boundary -= n;
+  } else {
+    // For bidirectional iterators, we need to check and advance step by step
+    for (size_t k = 0; k < n; ++k) {
+      EXPENSIVE_PRECONDITION(boundary != limit);
+      --boundary;
+    }
+  }
+}
+
+} // namespace detail
+
+/// The index `I` of a part, known at compile time.
+template <size_t I> struct part_index : std::integral_constant<size_t, I> {};
+
+template <std::forward_iterator Iterator, size_t K> class fixed_parts;
+
+namespace detail {
+struct partitioning_access;
+} // namespace detail
+
 /// A separation of some collection into multiple contiguous parts.
 ///
 /// A partitioning is constructed from a range defined by a pair of iterators.
@@ -23,6 +77,9 @@ public:
   using difference_type = std::iter_difference_t<Iterator>;
 
   /// An instance covering the range [begin, end), having just one part.
+  ///
+  /// Only the two boundaries of the part are allocated; use `reserve_parts` before adding many
+  /// parts.
   constexpr partitioning(Iterator begin, Iterator end);
 
   /// Returns the number of parts in the partitioning.
@@ -82,6 +139,17 @@ public:
   /// Adds `count` new empty parts at the beginning of the `i`th part.
   void add_parts_begin(size_t i, size_t count);
 
+  /// Ensures that the partitioning can hold `k` parts without reallocating its boundaries.
+  void reserve_parts(size_t k);
+
+  /// Releases the memory reserved for boundaries beyond the current parts.
+  void shrink_to_fit();
+
+  /// Returns the number of bytes used by `this`, including the memory allocated for boundaries
+  /// beyond the current parts.
+  [[nodiscard]]
+  size_t memory_footprint() const noexcept;
+
   /// Removes the `i`th part, growing the previous part to cover its range.
   ///
   /// - Precondition: `0 < i < parts_count()`
@@ -104,7 +172,27 @@ public:
   void shrink_by(size_t i, size_t n)
     requires std::bidirectional_iterator<Iterator>;
 
+  /// Returns a handle to the `K` parts of `this`, whose operations take part indices checked at
+  /// compile time instead of at each call.
+  ///
+  /// The handle is valid until a part is added or removed, or `reserve_parts` or `shrink_to_fit`
+  /// is called.
+  ///
+  /// - Precondition: `parts_count() == K`
+  template <size_t K> [[nodiscard]] fixed_parts<Iterator, K> with_parts() noexcept;
+
 private:
+  friend struct detail::partitioning_access;
+
+  /// Makes `position` the beginning of the `i`th part, and the end of the previous part.
+  ///
+  /// This is for algorithms relinking the nodes of linked lists, which reorders elements without
+  /// invalidating their iterators, so that boundaries must be repositioned.
+  ///
+  /// - Precondition: `i < parts_count()`
+  /// - Precondition: the boundaries stay in order
+  void set_part_begin(size_t i, Iterator position);
+
   /// The boundaries of each part in the partitioning.
   ///
   /// The first element is the begin iterator of the range, and the last
@@ -112,11 +200,80 @@ private:
   std::vector<Iterator> boundaries_{};
 };
 
+/// A handle to the `K` parts of a `partitioning`, whose part indices are checked at compile time.
+///
+/// The operations have the same semantics as the `partitioning` ones with the same names; the
+/// preconditions on part sizes are still checked according to the contract level.
+///
+/// - Invariant: `K >= 1`
+template <std::forward_iterator Iterator, size_t K> class fixed_parts {
+  static_assert(K >= 1);
+
+public:
+  /// Returns the number of parts, `K`.
+  static constexpr size_t parts_count() noexcept { return K; }
+
+  /// Returns the iterators delimiting the `I`th part.
+  template <size_t I>
+    requires(I < K)
+  [[nodiscard]] std::pair<Iterator, Iterator> part(part_index<I>) const noexcept;
+
+  /// Returns `true` if the `I`th part is empty.
+  template <size_t I>
+    requires(I < K)
+  [[nodiscard]] bool is_part_empty(part_index<I>) const noexcept;
+
+  /// Returns the size of the `I`th part.
+  ///
+  /// Complexity: O(1) for random access iterators, O(n) otherwise.
+  template <size_t I>
+    requires(I < K)
+  [[nodiscard]] size_t part_size(part_index<I>) const;
+
+  /// Moves the end of the `I`th part forward by `n` elements, taking them from the next part.
+  ///
+  /// - Precondition: `part_size(part_index<I + 1>{}) >= n`
+  /// - Complexity: O(n) for forward iterators, O(1) for random access iterators
+  template <size_t I>
+    requires(I + 1 < K)
+  void grow_by(part_index<I>, size_t n);
+
+  /// Moves the end of the `I`th part back by `n` elements, giving them to the next part.
+  ///
+  /// - Precondition: `part_size(part_index<I>{}) >= n`
+  /// - Complexity: O(n) for bidirectional iterators, O(1) for random access iterators
+  template <size_t I>
+    requires(I + 1 < K) && std::bidirectional_iterator<Iterator>
+  void shrink_by(part_index<I>, size_t n);
+
+  /// Transfers all the elements of the `I`th part to the previous part.
+  template <size_t I>
+    requires(0 < I && I < K)
+  void transfer_to_prev(part_index<I>) noexcept;
+
+  /// Transfers all the elements of the `I`th part to the next part.
+  template <size_t I>
+    requires(I + 1 < K)
+  void transfer_to_next(part_index<I>) noexcept;
+
+  /// Calls `f` with `part_index<I>{}` for each `I` in [0, K), in order.
+  template <typename F> void for_each_part(F&& f) const;
+
+private:
+  friend class partitioning<Iterator>;
+
+  /// An instance accessing the `K + 1` boundaries starting at `boundaries`.
+  explicit fixed_parts(Iterator* boundaries) noexcept : boundaries_(boundaries) {}
+
+  /// The boundaries of the parts.
+  Iterator* boundaries_;
+};
+
 // Inline definitions
 
 template <std::forward_iterator Iterator>
 inline constexpr partitioning<Iterator>::partitioning(Iterator begin, Iterator end) {
-  boundaries_.reserve(10);
+  boundaries_.reserve(2);
   boundaries_.emplace_back(std::move(begin));
   boundaries_.emplace_back(std::move(end));
 }
@@ -148,31 +305,22 @@ inline size_t partitioning<Iterator>::part_size(size_t i) const {
 template <std::forward_iterator Iterator> inline void partitioning<Iterator>::grow(size_t i) {
   PRECONDITION(i + 1 < parts_count());
   PRECONDITION(!is_part_empty(i + 1));
+  POSITIONLESS_TRACE_EVENT("grow", {"part", i});
   boundaries_[i + 1]++;
 }
 
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::grow_by(size_t i, size_t n) {
   PRECONDITION(i + 1 < parts_count());
-
-  if constexpr (std::random_access_iterator<Iterator>) {
-    // For random access iterators, we can check size and advance in O(1)
-    auto [begin, end] = part(i + 1);
-    PRECONDITION(static_cast<size_t>(std::distance(begin, end)) >= n);
-    boundaries_[i + 1] += n;
-  } else {
-    // For forward iterators, we need to check and advance step by step
-    for (size_t k = 0; k < n; ++k) {
-      PRECONDITION(!is_part_empty(i + 1));
-      boundaries_[i + 1]++;
-    }
-  }
+  POSITIONLESS_TRACE_EVENT("grow_by", {"part", i}, {"n", n});
+  detail::advance_boundary(boundaries_[i + 1], boundaries_[i + 2], n);
 }
 
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::transfer_to_prev(size_t i) {
   PRECONDITION(0 < i);
   PRECONDITION(i < parts_count());
+  POSITIONLESS_TRACE_EVENT("transfer_to_prev", {"part", i});
   // Transfer all elements to previous part by moving the boundary between them
   boundaries_[i] = boundaries_[i + 1];
 }
@@ -180,6 +328,7 @@ inline void partitioning<Iterator>::transfer_to_prev(size_t i) {
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::transfer_to_next(size_t i) {
   PRECONDITION(i < parts_count() - 1);
+  POSITIONLESS_TRACE_EVENT("transfer_to_next", {"part", i});
   // Transfer all elements to next part by moving the boundary between them
   boundaries_[i + 1] = boundaries_[i];
 }
@@ -187,39 +336,83 @@ inline void partitioning<Iterator>::transfer_to_next(size_t i) {
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::add_part_end(size_t i) {
   PRECONDITION(i < parts_count());
+  POSITIONLESS_TRACE_EVENT("add_part_end", {"part", i});
   boundaries_.insert(boundaries_.begin() + i + 1, boundaries_[i + 1]);
 }
 
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::add_part_begin(size_t i) {
   PRECONDITION(i < parts_count());
+  POSITIONLESS_TRACE_EVENT("add_part_begin", {"part", i});
   boundaries_.insert(boundaries_.begin() + i, boundaries_[i]);
 }
 
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::add_parts_end(size_t i, size_t count) {
   PRECONDITION(i < parts_count());
+  POSITIONLESS_TRACE_EVENT("add_parts_end", {"part", i}, {"count", count});
   boundaries_.insert(boundaries_.begin() + i + 1, count, boundaries_[i + 1]);
 }
 
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::add_parts_begin(size_t i, size_t count) {
   PRECONDITION(i < parts_count());
+  POSITIONLESS_TRACE_EVENT("add_parts_begin", {"part", i}, {"count", count});
   boundaries_.insert(boundaries_.begin() + i, count, boundaries_[i]);
 }
 
+template <std::forward_iterator Iterator>
+inline void partitioning<Iterator>::reserve_parts(size_t k) {
+  boundaries_.reserve(k + 1);
+}
+
+template <std::forward_iterator Iterator> inline void partitioning<Iterator>::shrink_to_fit() {
+  boundaries_.shrink_to_fit();
+}
+
+template <std::forward_iterator Iterator>
+inline size_t partitioning<Iterator>::memory_footprint() const noexcept {
+  return sizeof(*this) + boundaries_.capacity() * sizeof(Iterator);
+}
+
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::remove_part(size_t i) {
   PRECONDITION(i < parts_count());
+  POSITIONLESS_TRACE_EVENT("remove_part", {"part", i});
   boundaries_.erase(boundaries_.begin() + i);
 }
 
+template <std::forward_iterator Iterator>
+inline void partitioning<Iterator>::set_part_begin(size_t i, Iterator position) {
+  PRECONDITION(i < parts_count());
+  if constexpr (std::random_access_iterator<Iterator>) {
+    EXPENSIVE_PRECONDITION(i == 0 || boundaries_[i - 1] <= position);
+    EXPENSIVE_PRECONDITION(position <= boundaries_[i + 1]);
+  }
+  POSITIONLESS_TRACE_EVENT("set_part_begin", {"part", i});
+  boundaries_[i] = std::move(position);
+}
+
+namespace detail {
+
+/// Gives the algorithms relinking linked list nodes access to the boundaries of partitionings.
+struct partitioning_access {
+  /// Calls `p.set_part_begin(i, position)`.
+  template <std::forward_iterator Iterator>
+  static void set_part_begin(partitioning<Iterator>& p, size_t i, Iterator position) {
+    p.set_part_begin(i, std::move(position));
+  }
+};
+
+} // namespace detail
+
 template <std::forward_iterator Iterator>
 inline void partitioning<Iterator>::shrink(size_t i)
   requires std::bidirectional_iterator<Iterator>
 {
   PRECONDITION(i + 1 < parts_count());
   PRECONDITION(!is_part_empty(i));
+  POSITIONLESS_TRACE_EVENT("shrink", {"part", i});
   boundaries_[i + 1]--;
 }
 
@@ -228,19 +421,72 @@ inline void partitioning<Iterator>::shrink_by(size_t i, size_t n)
   requires std::bidirectional_iterator<Iterator>
 {
   PRECONDITION(i + 1 < parts_count());
+  POSITIONLESS_TRACE_EVENT("shrink_by", {"part", i}, {"n", n});
+  detail::retreat_boundary(boundaries_[i + 1], boundaries_[i], n);
+}
 
-  if constexpr (std::random_access_iterator<Iterator>) {
-    // For random access iterators, we can check size and advance in O(1)
-    auto [begin, end] = part(i);
-    PRECONDITION(static_cast<size_t>(std::distance(begin, end)) >= n);
-    boundaries_[i + 1] -= n;
-  } else {
-    // For bidirectional iterators, we need to check and advance step by step
-    for (size_t k = 0; k < n; ++k) {
-      PRECONDITION(!is_part_empty(i));
-      boundaries_[i + 1]--;
-    }
-  }
+template <std::forward_iterator Iterator>
+template <size_t K>
+inline fixed_parts<Iterator, K> partitioning<Iterator>::with_parts() noexcept {
+  PRECONDITION(parts_count() == K);
+  return fixed_parts<Iterator, K>(boundaries_.data());
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(I < K)
+inline std::pair<Iterator, Iterator> fixed_parts<Iterator, K>::part(part_index<I>) const noexcept {
+  return {boundaries_[I], boundaries_[I + 1]};
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(I < K)
+inline bool fixed_parts<Iterator, K>::is_part_empty(part_index<I>) const noexcept {
+  return boundaries_[I] == boundaries_[I + 1];
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(I < K)
+inline size_t fixed_parts<Iterator, K>::part_size(part_index<I>) const {
+  return std::distance(boundaries_[I], boundaries_[I + 1]);
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(I + 1 < K)
+inline void fixed_parts<Iterator, K>::grow_by(part_index<I>, size_t n) {
+  detail::advance_boundary(boundaries_[I + 1], boundaries_[I + 2], n);
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(I + 1 < K) && std::bidirectional_iterator<Iterator>
+inline void fixed_parts<Iterator, K>::shrink_by(part_index<I>, size_t n) {
+  detail::retreat_boundary(boundaries_[I + 1], boundaries_[I], n);
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(0 < I && I < K)
+inline void fixed_parts<Iterator, K>::transfer_to_prev(part_index<I>) noexcept {
+  boundaries_[I] = boundaries_[I + 1];
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <size_t I>
+  requires(I + 1 < K)
+inline void fixed_parts<Iterator, K>::transfer_to_next(part_index<I>) noexcept {
+  boundaries_[I + 1] = boundaries_[I];
+}
+
+template <std::forward_iterator Iterator, size_t K>
+template <typename F>
+inline void fixed_parts<Iterator, K>::for_each_part(F&& f) const {
+  [&]<size_t... I>(std::index_sequence<I...>) {
+    (f(part_index<I>{}), ...);
+  }(std::make_index_sequence<K>{});
 }
 
 } // namespace positionless
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "positionless/detail/byte_scan.hpp"
+#include "positionless/detail/precondition.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace positionless {
+
+namespace detail {
+
+/// `true` if `Iterator` points to contiguous bytes, which can be scanned with `memchr`.
+template <typename Iterator>
+inline constexpr bool is_contiguous_bytes =
+    std::contiguous_iterator<Iterator> && sizeof(std::iter_value_t<Iterator>) == 1 &&
+    std::is_integral_v<std::iter_value_t<Iterator>>;
+
+/// Returns the number of elements of [first, last) equal to `value`.
+template <std::forward_iterator Iterator>
+inline size_t
+count_elements(Iterator first, Iterator last, const std::iter_value_t<Iterator>& value) {
+  if constexpr (is_contiguous_bytes<Iterator>) {
+    const auto* p = reinterpret_cast<const char*>(std::to_address(first));
+    return count_byte(p, p + (last - first), static_cast<char>(value));
+  } else {
+    return static_cast<size_t>(std::count(first, last, value));
+  }
+}
+
+/// Returns the first element of [first, last) equal to `value`, or `last` if there is none.
+template <std::forward_iterator Iterator>
+inline Iterator
+find_element(Iterator first, Iterator last, const std::iter_value_t<Iterator>& value) {
+  if constexpr (is_contiguous_bytes<Iterator>) {
+    const auto* p = reinterpret_cast<const char*>(std::to_address(first));
+    const void* found =
+        std::memchr(p, static_cast<unsigned char>(value), static_cast<size_t>(last - first));
+    return found == nullptr ? last : first + (static_cast<const char*>(found) - p);
+  } else {
+    return std::find(first, last, value);
+  }
+}
+
+} // namespace detail
+
+/// Splits the only part of `p` into `n_parts` parts of roughly equal size, such that every part
+/// ends just after a `delimiter` element or at the end of the data.
+///
+/// The boundaries are first placed evenly, and then each one is moved forward to the start of the
+/// next record (a sequence of elements terminated by `delimiter`); thus, no record is split across
+/// two parts. Parts may end up empty if records are longer than `size / n_parts`.
+///
+/// - Precondition: `p.parts_count() == 1`
+/// - Precondition: `n_parts >= 1`
+/// - Postcondition: `p.parts_count() == n_parts`
+/// - Complexity: O(n) for forward iterators, O(n_parts + record length) for random access
+///   iterators.
+template <std::forward_iterator Iterator>
+inline void split_at_records(
+    partitioning<Iterator>& p, size_t n_parts, const std::iter_value_t<Iterator>& delimiter
+) {
+  PRECONDITION(p.parts_count() == 1);
+  PRECONDITION(n_parts >= 1);
+
+  auto [begin, end] = p.part(0);
+  const size_t n = static_cast<size_t>(std::distance(begin, end));
+
+  // The position (relative to `begin`) of the end of the last split part.
+  size_t done = 0;
+  Iterator cursor = begin;
+  for (size_t k = 1; k < n_parts; ++k) {
+    const size_t target = n / n_parts * k + n % n_parts * k / n_parts;
+    size_t boundary = done;
+    if (target > done) {
+      // Snap the even boundary to the start of the next record.
+      Iterator from =
+          std::next(cursor, static_cast<std::iter_difference_t<Iterator>>(target - done - 1));
+      Iterator found = detail::find_element(from, end, delimiter);
+      boundary = target - 1 + static_cast<size_t>(std::distance(from, found));
+      if (found != end)
+        ++boundary;
+    }
+
+    p.add_part_begin(p.parts_count() - 1);
+    p.grow_by(p.parts_count() - 2, boundary - done);
+    cursor = p.part(p.parts_count() - 1).first;
+    done = boundary;
+  }
+}
+
+/// Splits the `i`th part of `p` into one part per line, and returns the number of lines.
+///
+/// Each part contains a line and its terminating `newline`, except the last line of the part if
+/// it has no terminating `newline`. An empty part is left as a single empty line.
+///
+/// The newlines are counted first, so that the boundaries are allocated at most once. Contiguous
+/// bytes are counted a machine word at a time and searched with `memchr`.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(part_size(i) + lines * (p.parts_count() - i))
+template <std::forward_iterator Iterator>
+inline size_t split_lines(
+    partitioning<Iterator>& p, size_t i, const std::iter_value_t<Iterator>& newline = '\n'
+) {
+  PRECONDITION(i < p.parts_count());
+
+  auto [first, last] = p.part(i);
+  // Each newline but a final one ends a line that is split off.
+  p.reserve_parts(p.parts_count() + detail::count_elements(first, last, newline));
+
+  size_t lines = 1;
+  for (;;) {
+    const Iterator found = detail::find_element(first, last, newline);
+    if (found == last)
+      break;
+    const Iterator line_end = std::next(found);
+    if (line_end == last)
+      break;
+    p.add_part_begin(i + lines - 1);
+    p.grow_by(i + lines - 1, static_cast<size_t>(std::distance(first, line_end)));
+    first = line_end;
+    ++lines;
+  }
+  return lines;
+}
+
+/// A header decoder for records prefixed by their payload length, stored as a `Bytes`-byte
+/// unsigned integer in `Order` byte order.
+template <size_t Bytes, std::endian Order = std::endian::big>
+  requires(Bytes >= 1 && Bytes <= 8)
+struct fixed_length_prefix {
+  /// The size of the header of each record.
+  static constexpr size_t header_size = Bytes;
+
+  /// Returns the size of the record starting at `first` (header included), or `std::nullopt` if
+  /// [first, last) is too short to contain its header.
+  ///
+  /// Throws `std::runtime_error` if the size does not fit in `size_t`.
+  template <std::forward_iterator Iterator>
+  std::optional<size_t> operator()(Iterator first, Iterator last) const {
+    uint64_t length = 0;
+    for (size_t k = 0; k < Bytes; ++k, ++first) {
+      if (first == last)
+        return std::nullopt;
+      const auto byte = static_cast<uint64_t>(static_cast<unsigned char>(*first));
+      if constexpr (Order == std::endian::big)
+        length = (length << 8) | byte;
+      else
+        length |= byte << (8 * k);
+    }
+    if (length > std::numeric_limits<size_t>::max() - Bytes)
+      throw std::runtime_error("fixed_length_prefix: record length overflows");
+    return Bytes + static_cast<size_t>(length);
+  }
+};
+
+/// Splits the `i`th part of `p`, holding a sequence of length-prefixed records, into one part per
+/// complete record followed by a part holding the trailing incomplete record (possibly empty), and
+/// returns the number of complete records.
+///
+/// `header_decoder(first, last)` must return the size of the record starting at `first`, header
+/// included, or `std::nullopt` if [first, last) does not contain its whole header.
+///
+/// Throws `std::runtime_error` if a record has size 0, or is smaller than
+/// `HeaderDecoder::header_size` when the decoder defines it (as `fixed_length_prefix` does). The
+/// whole part is decoded before it is split: if a record is rejected, or `header_decoder` throws,
+/// `p` is left unchanged.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(records * (p.parts_count() - i)) plus the cost of decoding the headers for
+///   random access iterators; O(part_size(i)) more for other iterators.
+template <std::forward_iterator Iterator, typename HeaderDecoder>
+  requires std::is_invocable_r_v<std::optional<size_t>, const HeaderDecoder&, Iterator, Iterator>
+inline size_t
+split_length_prefixed(partitioning<Iterator>& p, size_t i, const HeaderDecoder& header_decoder) {
+  PRECONDITION(i < p.parts_count());
+
+  // The sizes of the complete records, found before `p` is modified.
+  std::vector<size_t> sizes;
+  auto [first, last] = p.part(i);
+  size_t remaining = p.part_size(i);
+  for (;;) {
+    const std::optional<size_t> size = header_decoder(first, last);
+    if (!size || *size > remaining)
+      break;
+    if (*size == 0)
+      throw std::runtime_error("split_length_prefixed: invalid record length");
+    if constexpr (requires { HeaderDecoder::header_size; }) {
+      if (*size < HeaderDecoder::header_size)
+        throw std::runtime_error("split_length_prefixed: record smaller than its header");
+    }
+    sizes.push_back(*size);
+    std::advance(first, *size);
+    remaining -= *size;
+  }
+
+  for (size_t k = 0; k < sizes.size(); ++k) {
+    p.add_part_begin(i + k);
+    p.grow_by(i + k, sizes[k]);
+  }
+  return sizes.size();
+}
+
+} // namespace positionless
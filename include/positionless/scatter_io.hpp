@@ -0,0 +1,120 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace positionless {
+
+namespace detail {
+
+/// The maximum number of buffers passed to a single `writev`.
+#if defined(IOV_MAX)
+inline constexpr size_t max_iovecs = IOV_MAX;
+#else
+inline constexpr size_t max_iovecs = 1024;
+#endif
+
+/// Writes all the bytes described by `iov` to `fd`, resuming after partial writes.
+///
+/// Throws `std::system_error` on failure.
+inline void writev_all(int fd, std::span<iovec> iov) {
+  while (!iov.empty()) {
+    const size_t count = std::min(iov.size(), max_iovecs);
+    const ssize_t r = ::writev(fd, iov.data(), static_cast<int>(count));
+    if (r < 0) {
+      if (errno == EINTR)
+        continue;
+      throw std::system_error(errno, std::generic_category(), "writev_parts: writev");
+    }
+
+    // Skip the buffers written completely, and adjust the first one written partially.
+    auto written = static_cast<size_t>(r);
+    while (!iov.empty() && written >= iov.front().iov_len) {
+      written -= iov.front().iov_len;
+      iov = iov.subspan(1);
+    }
+    if (written != 0) {
+      iov.front().iov_base = static_cast<char*>(iov.front().iov_base) + written;
+      iov.front().iov_len -= written;
+    }
+  }
+}
+
+} // namespace detail
+
+/// Writes the elements of parts [i, j) of `p`, in order, to the file descriptor `fd`, and returns
+/// the number of bytes written.
+///
+/// The bytes are gathered directly from the parts with `writev`, in batches of up to `IOV_MAX`
+/// parts, without copying them into an intermediate buffer.
+///
+/// Throws `std::system_error` on failure.
+///
+/// - Precondition: `i <= j <= p.parts_count()`
+template <std::contiguous_iterator Iterator>
+inline size_t writev_parts(const partitioning<Iterator>& p, size_t i, size_t j, int fd) {
+  PRECONDITION(i <= j);
+  PRECONDITION(j <= p.parts_count());
+
+  using value_type = std::iter_value_t<Iterator>;
+  std::vector<iovec> iov;
+  iov.reserve(j - i);
+  size_t total = 0;
+  for (size_t k = i; k < j; ++k) {
+    const auto [first, last] = p.part(k);
+    if (first == last)
+      continue;
+    const size_t bytes = static_cast<size_t>(last - first) * sizeof(value_type);
+    iov.push_back({const_cast<std::remove_const_t<value_type>*>(std::to_address(first)), bytes});
+    total += bytes;
+  }
+  detail::writev_all(fd, iov);
+  return total;
+}
+
+/// Writes the elements of all the parts of `p`, in order, to the file descriptor `fd`, and returns
+/// the number of bytes written.
+///
+/// Throws `std::system_error` on failure.
+template <std::contiguous_iterator Iterator>
+inline size_t writev_parts(const partitioning<Iterator>& p, int fd) {
+  return writev_parts(p, 0, p.parts_count(), fd);
+}
+
+/// Writes the elements of each part `i` of `p` to the file descriptor `fds[i]`, and returns the
+/// total number of bytes written.
+///
+/// Consecutive parts written to the same file descriptor are gathered into the same `writev`s.
+///
+/// Throws `std::system_error` on failure.
+///
+/// - Precondition: `fds.size() == p.parts_count()`
+template <std::contiguous_iterator Iterator>
+inline size_t write_parts(const partitioning<Iterator>& p, std::span<const int> fds) {
+  PRECONDITION(fds.size() == p.parts_count());
+
+  size_t total = 0;
+  for (size_t i = 0; i < fds.size();) {
+    size_t j = i + 1;
+    while (j < fds.size() && fds[j] == fds[i])
+      ++j;
+    total += writev_parts(p, i, j, fds[i]);
+    i = j;
+  }
+  return total;
+}
+
+} // namespace positionless
@@ -0,0 +1,257 @@
+#pragma once
+
+#include "positionless/algorithms.hpp"
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/segments.hpp"
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace positionless {
+
+namespace detail {
+
+/// A non-empty buffer of a segmented range, and the position of its first element in the range.
+template <typename T> struct segment {
+  /// The first element of the buffer.
+  T* first{nullptr};
+  /// The end of the buffer.
+  T* last{nullptr};
+  /// The number of elements of the range before the buffer.
+  ptrdiff_t offset{0};
+};
+
+/// The buffers of a segmented range, followed by an empty sentinel segment positioned at the end
+/// of the range.
+template <typename T> using segment_table = std::vector<segment<T>>;
+
+} // namespace detail
+
+/// A random access iterator over a sequence of buffers, presented as one range.
+///
+/// Moving by one element, within a buffer or to the next one, takes constant time; jumps to
+/// another buffer take O(log buffers). `for_each_segment` passes the buffers as pointers.
+template <typename T> class segmented_iterator {
+public:
+  using value_type = std::remove_cv_t<T>;
+  using difference_type = ptrdiff_t;
+  using reference = T&;
+  using pointer = T*;
+  using iterator_category = std::random_access_iterator_tag;
+  /// The type of the segments passed by `for_each_segment_to`.
+  using segment_pointer = T*;
+
+  /// A singular instance.
+  segmented_iterator() = default;
+
+  /// An instance at `position`, in the segment `s` of `table`.
+  segmented_iterator(
+      const detail::segment_table<T>* table, const detail::segment<T>* s, T* position
+  )
+      : table_(table), segment_(s), position_(position) {}
+
+  reference operator*() const { return *position_; }
+
+  pointer operator->() const { return position_; }
+
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  segmented_iterator& operator++() {
+    if (++position_ == segment_->last) {
+      ++segment_;
+      position_ = segment_->first;
+    }
+    return *this;
+  }
+
+  segmented_iterator operator++(int) {
+    segmented_iterator r = *this;
+    ++*this;
+    return r;
+  }
+
+  segmented_iterator& operator--() {
+    if (position_ == segment_->first) {
+      --segment_;
+      position_ = segment_->last;
+    }
+    --position_;
+    return *this;
+  }
+
+  segmented_iterator operator--(int) {
+    segmented_iterator r = *this;
+    --*this;
+    return r;
+  }
+
+  segmented_iterator& operator+=(difference_type n) {
+    const difference_type local = position_ - segment_->first + n;
+    if (local >= 0 && local < segment_->last - segment_->first) {
+      position_ += n;
+      return *this;
+    }
+    // The segment holding the target is the last one starting at or before it.
+    const difference_type target = segment_->offset + local;
+    const auto next = std::ranges::upper_bound(*table_, target, {}, &detail::segment<T>::offset);
+    segment_ = &*(next - 1);
+    position_ = segment_->first + (target - segment_->offset);
+    return *this;
+  }
+
+  segmented_iterator& operator-=(difference_type n) { return *this += -n; }
+
+  friend segmented_iterator operator+(segmented_iterator i, difference_type n) { return i += n; }
+
+  friend segmented_iterator operator+(difference_type n, segmented_iterator i) { return i += n; }
+
+  friend segmented_iterator operator-(segmented_iterator i, difference_type n) { return i -= n; }
+
+  friend difference_type operator-(const segmented_iterator& a, const segmented_iterator& b) {
+    return a.index() - b.index();
+  }
+
+  /// Positions are unique across segments, the sentinel segment having none.
+  friend bool operator==(const segmented_iterator& a, const segmented_iterator& b) {
+    return a.position_ == b.position_;
+  }
+
+  friend std::strong_ordering
+  operator<=>(const segmented_iterator& a, const segmented_iterator& b) {
+    return a.index() <=> b.index();
+  }
+
+  /// Calls `f(segment_first, segment_last)` with the pointers delimiting each contiguous segment
+  /// of [*this, last), in order.
+  template <typename F> void for_each_segment_to(const segmented_iterator& last, F&& f) const {
+    if (segment_ == last.segment_) {
+      f(position_, last.position_);
+      return;
+    }
+    f(position_, segment_->last);
+    for (auto s = segment_ + 1; s != last.segment_; ++s)
+      f(s->first, s->last);
+    f(last.segment_->first, last.position_);
+  }
+
+private:
+  /// Returns the position of `this` in the range.
+  difference_type index() const { return segment_->offset + (position_ - segment_->first); }
+
+  /// The segments of the range.
+  const detail::segment_table<T>* table_{nullptr};
+  /// The segment holding the element pointed to, or the sentinel segment for the end.
+  const detail::segment<T>* segment_{nullptr};
+  /// The element pointed to, or `nullptr` for the end.
+  T* position_{nullptr};
+};
+
+namespace detail {
+
+/// The segments of a `segmented_partitioning`, allocated separately so that they stay in place
+/// when the partitioning is moved.
+template <typename T> class segment_storage {
+public:
+  /// An instance describing `buffers`, skipping the empty ones.
+  template <std::ranges::input_range Buffers>
+  explicit segment_storage(Buffers&& buffers) : segments_(std::make_unique<segment_table<T>>()) {
+    ptrdiff_t offset = 0;
+    for (std::span<T> b : buffers) {
+      if (b.empty())
+        continue;
+      segments_->push_back({b.data(), b.data() + b.size(), offset});
+      offset += static_cast<ptrdiff_t>(b.size());
+    }
+    segments_->push_back({nullptr, nullptr, offset});
+  }
+
+  /// Returns an iterator to the first element.
+  segmented_iterator<T> segments_begin() const {
+    const auto& s = *segments_;
+    return {segments_.get(), s.data(), s.front().first};
+  }
+
+  /// Returns an iterator past the last element.
+  segmented_iterator<T> segments_end() const {
+    const auto& s = *segments_;
+    return {segments_.get(), s.data() + s.size() - 1, nullptr};
+  }
+
+  /// Returns the number of non-empty buffers.
+  size_t segments_count() const noexcept { return segments_->size() - 1; }
+
+private:
+  /// The segments.
+  std::unique_ptr<segment_table<T>> segments_;
+};
+
+} // namespace detail
+
+/// A partitioning over a sequence of buffers (e.g., fixed-size pages), presented as one range
+/// whose parts may span buffer edges.
+///
+/// The buffers are not copied, and must outlive the instance. The algorithms of
+/// `positionless/segments.hpp` process each buffer with pointer loops, and `sort_part` sorts the
+/// elements of each buffer with pointer loops before merging across buffers.
+///
+/// - Invariant: parts_count() >= 1
+template <typename T>
+class segmented_partitioning : private detail::segment_storage<T>,
+                               public partitioning<segmented_iterator<T>> {
+public:
+  /// An instance over the concatenation of `buffers`, a range of contiguous ranges of `T` (e.g.,
+  /// `std::span<T>`s or `std::vector<T>`s), having just one part covering all their elements.
+  template <std::ranges::input_range Buffers>
+    requires std::convertible_to<std::ranges::range_reference_t<Buffers>, std::span<T>>
+  explicit segmented_partitioning(Buffers&& buffers)
+      : detail::segment_storage<T>(buffers),
+        partitioning<segmented_iterator<T>>(this->segments_begin(), this->segments_end()) {}
+
+  /// Returns the number of non-empty buffers.
+  using detail::segment_storage<T>::segments_count;
+};
+
+/// Sorts the elements of the `i`th part of `p` like the generic `sort_part`, but sorts the
+/// elements of each buffer with pointer loops before merging across buffers.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(n log n) comparisons if additional memory is available, where `n` is the size
+///   of the part.
+template <typename T, typename Compare = std::less<>>
+inline size_t sort_part(partitioning<segmented_iterator<T>>& p, size_t i, Compare comp = {}) {
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("sort_part: segmented", {"part", i});
+
+  const auto [first, last] = p.part(i);
+  size_t runs = 0;
+  std::vector<size_t> piece_sizes;
+  for_each_segment(first, last, [&](T* piece_first, T* piece_last) {
+    if (piece_first == piece_last)
+      return;
+    partitioning<T*> piece(piece_first, piece_last);
+    runs += sort_part(piece, 0, comp);
+    piece_sizes.push_back(static_cast<size_t>(piece_last - piece_first));
+  });
+  if (piece_sizes.size() <= 1)
+    return std::max<size_t>(runs, 1);
+
+  p.reserve_parts(p.parts_count() + piece_sizes.size() - 1);
+  for (size_t k = 0; k + 1 < piece_sizes.size(); ++k) {
+    p.add_part_begin(i + k);
+    p.grow_by(i + k, piece_sizes[k]);
+  }
+  merge_parts(p, i, piece_sizes.size(), comp);
+  return runs;
+}
+
+} // namespace positionless
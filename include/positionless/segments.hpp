@@ -0,0 +1,138 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace positionless {
+
+namespace detail {
+
+/// `true` if `Iterator` is a `std::deque` iterator of libstdc++, whose blocks are accessible.
+template <typename Iterator> inline constexpr bool is_libstdcxx_deque_iterator = false;
+
+#if defined(__GLIBCXX__)
+template <typename T, typename Reference, typename Pointer>
+inline constexpr bool is_libstdcxx_deque_iterator<std::_Deque_iterator<T, Reference, Pointer>> =
+    true;
+#endif
+
+/// `true` if `Iterator` passes its contiguous segments to a member function
+/// `for_each_segment_to(last, f)`, as `Iterator::segment_pointer`s.
+template <typename Iterator>
+concept provides_segments = requires(const Iterator& i) {
+  typename Iterator::segment_pointer;
+  i.for_each_segment_to(
+      i, [](typename Iterator::segment_pointer, typename Iterator::segment_pointer) {}
+  );
+};
+
+} // namespace detail
+
+/// `true` if `for_each_segment` passes pointers for ranges of `Iterator`s.
+template <typename Iterator>
+inline constexpr bool has_contiguous_segments =
+    std::contiguous_iterator<Iterator> || detail::is_libstdcxx_deque_iterator<Iterator> ||
+    detail::provides_segments<Iterator>;
+
+/// Calls `f(segment_first, segment_last)` for each segment of [first, last), in order.
+///
+/// If `has_contiguous_segments<Iterator>`, the segments are the maximal contiguous subranges of
+/// [first, last) (e.g. the blocks of a `std::deque`, or the buffers of a `segmented_iterator`),
+/// passed as pointers, so that `f` can loop over them without the per-increment checks of
+/// `Iterator`; empty segments may be passed. Otherwise, [first, last) is passed as a single
+/// segment of `Iterator`s.
+///
+/// - Complexity: O(number of segments) calls of `f`
+template <std::forward_iterator Iterator, typename F>
+inline void for_each_segment(Iterator first, Iterator last, F&& f) {
+  if constexpr (std::contiguous_iterator<Iterator>) {
+    f(std::to_address(first), std::to_address(first) + (last - first));
+  } else if constexpr (detail::provides_segments<Iterator>) {
+    first.for_each_segment_to(last, f);
+  } else if constexpr (detail::is_libstdcxx_deque_iterator<Iterator>) {
+    using pointer = decltype(std::to_address(first));
+    if (first._M_node == last._M_node) {
+      f(pointer(first._M_cur), pointer(last._M_cur));
+      return;
+    }
+    f(pointer(first._M_cur), pointer(first._M_last));
+    const auto block_size = first._M_last - first._M_first;
+    for (auto node = first._M_node + 1; node != last._M_node; ++node)
+      f(pointer(*node), pointer(*node + block_size));
+    f(pointer(last._M_first), pointer(last._M_cur));
+  } else {
+    f(first, last);
+  }
+}
+
+/// Calls `f` with each element of the `i`th part of `p`, in order, looping over the contiguous
+/// segments of the part.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(part_size(i)) calls of `f`
+template <std::forward_iterator Iterator, typename F>
+inline void for_each_element(const partitioning<Iterator>& p, size_t i, F f) {
+  PRECONDITION(i < p.parts_count());
+  const auto [first, last] = p.part(i);
+  for_each_segment(first, last, [&](auto segment_first, auto segment_last) {
+    for (; segment_first != segment_last; ++segment_first)
+      f(*segment_first);
+  });
+}
+
+/// Returns the result of folding the elements of the `i`th part of `p`, in order, into `init`
+/// with `op`, looping over the contiguous segments of the part.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(part_size(i)) calls of `op`
+template <std::forward_iterator Iterator, typename T, typename Op = std::plus<>>
+inline T reduce_elements(const partitioning<Iterator>& p, size_t i, T init, Op op = {}) {
+  PRECONDITION(i < p.parts_count());
+  const auto [first, last] = p.part(i);
+  for_each_segment(first, last, [&](auto segment_first, auto segment_last) {
+    for (; segment_first != segment_last; ++segment_first)
+      init = op(std::move(init), *segment_first);
+  });
+  return init;
+}
+
+/// Reorders the elements of the `i`th part of `p` so that those satisfying `pred` come first, and
+/// splits the part after them, making the others the new part `i + 1`.
+///
+/// The elements are read by looping over the contiguous segments of the part. The partition is
+/// not stable.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: O(part_size(i)) calls of `pred` and swaps, plus O(p.parts_count() - i)
+template <std::forward_iterator Iterator, typename Predicate>
+inline void partition_part(partitioning<Iterator>& p, size_t i, Predicate pred) {
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("partition_part", {"part", i});
+
+  const auto [first, last] = p.part(i);
+  // Elements satisfying `pred` are swapped to the front; the swaps go through `Iterator`, but the
+  // reads, which are more frequent, go through the segments.
+  Iterator satisfying_end = first;
+  size_t satisfying = 0;
+  for_each_segment(first, last, [&](auto segment_first, auto segment_last) {
+    for (; segment_first != segment_last; ++segment_first) {
+      if (pred(std::as_const(*segment_first))) {
+        std::ranges::iter_swap(satisfying_end, segment_first);
+        ++satisfying_end;
+        ++satisfying;
+      }
+    }
+  });
+  p.add_part_begin(i);
+  p.grow_by(i, satisfying);
+}
+
+} // namespace positionless
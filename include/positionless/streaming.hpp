@@ -0,0 +1,172 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <unistd.h>
+
+namespace positionless {
+
+/// A partitioning of a fixed-size buffer that is repeatedly filled from a sequential input (a
+/// stream or a file descriptor, e.g., a pipe), separating complete records from a trailing partial
+/// record.
+///
+/// The buffer always has three parts:
+/// - part 0: the complete records read by the last `refill()`, each ending with the delimiter
+///   (except possibly the last record of the input);
+/// - part 1: the trailing partial record, which is completed by the next `refill()`;
+/// - part 2: the unused capacity of the buffer.
+///
+/// The buffer is allocated once, at construction; refilling moves the partial record to the front
+/// of the buffer and only adjusts the boundaries between the parts, so memory usage is constant
+/// regardless of the input size.
+class streaming_partitioning {
+public:
+  /// An instance reading records ending with `delimiter` from `in`, using a buffer of
+  /// `buffer_size` bytes.
+  ///
+  /// - Precondition: `buffer_size > 0`
+  streaming_partitioning(std::istream& in, size_t buffer_size, char delimiter = '\n');
+
+  /// An instance reading records ending with `delimiter` from the file descriptor `fd`, using a
+  /// buffer of `buffer_size` bytes.
+  ///
+  /// - Precondition: `buffer_size > 0`
+  streaming_partitioning(int fd, size_t buffer_size, char delimiter = '\n');
+
+  /// Discards the complete records, moves the partial record to the front of the buffer, and reads
+  /// more data from the input; returns `false` if the input was already exhausted.
+  ///
+  /// When the input ends, the trailing partial record is exposed as the last complete record.
+  ///
+  /// Throws `std::length_error` if a record does not fit in the buffer, and `std::system_error` or
+  /// `std::ios_base::failure` on read errors.
+  bool refill();
+
+  /// Returns the partitioning of the buffer.
+  [[nodiscard]]
+  const partitioning<const char*>& parts() const noexcept {
+    return parts_;
+  }
+
+  /// Returns the complete records read by the last `refill()`.
+  [[nodiscard]]
+  std::pair<const char*, const char*> records() const noexcept {
+    return parts_.part(0);
+  }
+
+  /// Returns `true` if all the input has been read.
+  [[nodiscard]]
+  bool at_end() const noexcept {
+    return at_end_;
+  }
+
+private:
+  /// Reads at most `n` bytes into `dst`, returning the number of bytes read; 0 means end of input.
+  size_t read_some(char* dst, size_t n);
+
+  /// The stream to read from, if reading from a stream.
+  std::istream* in_{nullptr};
+  /// The file descriptor to read from, if reading from a file descriptor.
+  int fd_{-1};
+  /// The character ending each record.
+  char delimiter_;
+  /// The size of `buffer_`.
+  size_t capacity_;
+  /// The storage for the data.
+  std::unique_ptr<char[]> buffer_;
+  /// The records, partial record, and free space of `buffer_`.
+  partitioning<const char*> parts_;
+  /// `true` if the input is exhausted.
+  bool at_end_{false};
+};
+
+// Inline definitions
+
+inline streaming_partitioning::streaming_partitioning(
+    std::istream& in, size_t buffer_size, char delimiter
+)
+    : streaming_partitioning(-1, buffer_size, delimiter) {
+  in_ = &in;
+}
+
+inline streaming_partitioning::streaming_partitioning(int fd, size_t buffer_size, char delimiter)
+    : fd_(fd), delimiter_(delimiter), capacity_(buffer_size),
+      buffer_(std::make_unique_for_overwrite<char[]>(buffer_size)),
+      parts_(buffer_.get(), buffer_.get() + buffer_size) {
+  PRECONDITION(buffer_size > 0);
+  parts_.add_parts_begin(0, 2);
+}
+
+inline bool streaming_partitioning::refill() {
+  if (at_end_) {
+    // Expose nothing after the last records.
+    parts_.transfer_to_next(0);
+    parts_.transfer_to_next(1);
+    return false;
+  }
+
+  // Move the partial record to the front of the buffer.
+  const auto [tail_begin, tail_end] = parts_.part(1);
+  const size_t tail_size = static_cast<size_t>(tail_end - tail_begin);
+  std::memmove(buffer_.get(), tail_begin, tail_size);
+
+  // Fill the free space, as far as the input allows.
+  size_t filled = tail_size;
+  while (filled < capacity_) {
+    const size_t n = read_some(buffer_.get() + filled, capacity_ - filled);
+    if (n == 0) {
+      at_end_ = true;
+      break;
+    }
+    filled += n;
+  }
+
+  // Make the filled data the partial record, then split off the complete records.
+  parts_.transfer_to_next(0);
+  parts_.transfer_to_next(1);
+  parts_.grow_by(1, filled);
+
+  if (at_end_) {
+    parts_.transfer_to_prev(1);
+    return filled != 0;
+  }
+
+  // Everything up to the last delimiter forms complete records.
+  const char* data = buffer_.get();
+  const auto last = std::find(
+      std::make_reverse_iterator(data + filled), std::make_reverse_iterator(data), delimiter_
+  );
+  if (last.base() == data && filled == capacity_)
+    throw std::length_error("streaming_partitioning: record does not fit in the buffer");
+  parts_.grow_by(0, static_cast<size_t>(last.base() - data));
+  return true;
+}
+
+inline size_t streaming_partitioning::read_some(char* dst, size_t n) {
+  if (in_ != nullptr) {
+    in_->read(dst, static_cast<std::streamsize>(n));
+    if (in_->bad())
+      throw std::ios_base::failure("streaming_partitioning: stream read failed");
+    return static_cast<size_t>(in_->gcount());
+  }
+  for (;;) {
+    const ssize_t r = ::read(fd_, dst, n);
+    if (r >= 0)
+      return static_cast<size_t>(r);
+    if (errno != EINTR)
+      throw std::system_error(errno, std::generic_category(), "streaming_partitioning: read");
+  }
+}
+
+} // namespace positionless
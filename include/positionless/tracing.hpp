@@ -0,0 +1,243 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/// The number of events kept per thread; older events are overwritten.
+#if !defined(POSITIONLESS_TRACE_BUFFER_EVENTS)
+#define POSITIONLESS_TRACE_BUFFER_EVENTS 16384
+#endif
+
+namespace positionless {
+
+/// A named integer argument of a trace event.
+struct trace_argument {
+  /// The name of the argument, or `nullptr` if the argument is absent.
+  const char* name{nullptr};
+  /// The value of the argument.
+  uint64_t value{0};
+};
+
+/// An event recorded by the tracing hooks.
+struct trace_event {
+  /// The name of the event; a string literal.
+  const char* name{nullptr};
+  /// The time at which the event started, in nanoseconds since an arbitrary epoch.
+  uint64_t start_ns{0};
+  /// The duration of the event in nanoseconds; 0 for instant events.
+  uint64_t duration_ns{0};
+  /// The index of the thread that recorded the event, in order of first recording.
+  uint32_t thread{0};
+  /// `true` for events with a duration, `false` for instant events.
+  bool complete{false};
+  /// The arguments of the event.
+  trace_argument arguments[2]{};
+};
+
+namespace detail {
+
+/// The events recorded by one thread, in a ring buffer written only by that thread.
+///
+/// When the thread exits, the buffer is recycled for the next thread that records events; the
+/// events already recorded are kept until they are overwritten.
+struct trace_buffer {
+  /// The events; event `k` is at index `k % POSITIONLESS_TRACE_BUFFER_EVENTS`.
+  std::unique_ptr<trace_event[]> events{new trace_event[POSITIONLESS_TRACE_BUFFER_EVENTS]};
+  /// The number of events recorded since the last clear.
+  std::atomic<uint64_t> recorded{0};
+  /// The index of the thread owning the buffer.
+  uint32_t thread{0};
+};
+
+/// The buffers of all the threads that recorded events, with the mutex protecting them.
+struct trace_registry {
+  std::mutex mutex;
+  /// All the buffers, in order of creation.
+  std::vector<std::unique_ptr<trace_buffer>> buffers;
+  /// The buffers of the threads that exited, ready for reuse.
+  std::vector<trace_buffer*> free_buffers;
+  /// The number of threads that recorded events.
+  uint32_t threads{0};
+};
+
+/// Returns the registry of all trace buffers.
+inline trace_registry& trace_buffers() {
+  static trace_registry r;
+  return r;
+}
+
+/// The use of a trace buffer by a thread, returning it to the registry when the thread exits.
+class trace_buffer_lease {
+public:
+  /// An instance using a free buffer of the registry, or a new one.
+  trace_buffer_lease() {
+    auto& registry = trace_buffers();
+    const std::lock_guard lock(registry.mutex);
+    if (registry.free_buffers.empty()) {
+      registry.buffers.push_back(std::make_unique<trace_buffer>());
+      buffer_ = registry.buffers.back().get();
+    } else {
+      buffer_ = registry.free_buffers.back();
+      registry.free_buffers.pop_back();
+    }
+    buffer_->thread = registry.threads++;
+  }
+
+  trace_buffer_lease(const trace_buffer_lease&) = delete;
+  trace_buffer_lease& operator=(const trace_buffer_lease&) = delete;
+
+  /// Returns the buffer to the registry.
+  ~trace_buffer_lease() {
+    auto& registry = trace_buffers();
+    const std::lock_guard lock(registry.mutex);
+    registry.free_buffers.push_back(buffer_);
+  }
+
+  /// Returns the buffer.
+  trace_buffer& buffer() const noexcept { return *buffer_; }
+
+private:
+  /// The buffer used by the thread.
+  trace_buffer* buffer_;
+};
+
+/// Returns the buffer of the calling thread, acquiring it on first use.
+inline trace_buffer& this_thread_trace_buffer() {
+  thread_local const trace_buffer_lease lease;
+  return lease.buffer();
+}
+
+/// Returns the current time in nanoseconds.
+inline uint64_t trace_now() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()
+      )
+          .count()
+  );
+}
+
+/// Records `e` in the buffer of the calling thread.
+///
+/// The slot is written before the count is published, so readers only see complete events unless
+/// the buffer wraps around while they read.
+inline void record_trace_event(trace_event e) {
+  trace_buffer& b = this_thread_trace_buffer();
+  const uint64_t k = b.recorded.load(std::memory_order_relaxed);
+  e.thread = b.thread;
+  b.events[k % POSITIONLESS_TRACE_BUFFER_EVENTS] = e;
+  b.recorded.store(k + 1, std::memory_order_release);
+}
+
+/// Records an instant event named `name` with arguments `a` and `b`.
+inline void record_trace_instant(const char* name, trace_argument a = {}, trace_argument b = {}) {
+  record_trace_event({name, trace_now(), 0, 0, false, {a, b}});
+}
+
+/// Writes `s` to `os` as a JSON string.
+inline void write_json_string(std::ostream& os, const char* s) {
+  os << '"';
+  for (; *s != 0; ++s) {
+    if (*s == '"' || *s == '\\')
+      os << '\\';
+    os << *s;
+  }
+  os << '"';
+}
+
+} // namespace detail
+
+/// Records an event spanning its lifetime, named `name` and with arguments `a` and `b`.
+class trace_scope {
+public:
+  /// An instance starting the event.
+  explicit trace_scope(const char* name, trace_argument a = {}, trace_argument b = {})
+      : event_{name, detail::trace_now(), 0, 0, true, {a, b}} {}
+
+  trace_scope(const trace_scope&) = delete;
+  trace_scope& operator=(const trace_scope&) = delete;
+
+  /// Ends and records the event.
+  ~trace_scope() {
+    event_.duration_ns = detail::trace_now() - event_.start_ns;
+    detail::record_trace_event(event_);
+  }
+
+private:
+  /// The event being recorded.
+  trace_event event_;
+};
+
+/// Returns the events kept in all the thread buffers, ordered by thread and then by recording.
+///
+/// Events recorded concurrently with the call may be missing or, if a buffer wraps around during
+/// the call, garbled; call it when the traced threads are idle.
+inline std::vector<trace_event> collect_trace() {
+  auto& registry = detail::trace_buffers();
+  const std::lock_guard lock(registry.mutex);
+  std::vector<trace_event> r;
+  for (const auto& b : registry.buffers) {
+    const uint64_t end = b->recorded.load(std::memory_order_acquire);
+    const uint64_t begin = end > POSITIONLESS_TRACE_BUFFER_EVENTS
+                               ? end - POSITIONLESS_TRACE_BUFFER_EVENTS
+                               : 0;
+    for (uint64_t k = begin; k < end; ++k)
+      r.push_back(b->events[k % POSITIONLESS_TRACE_BUFFER_EVENTS]);
+  }
+  // A recycled buffer holds the events of several threads, in order of recording.
+  std::ranges::stable_sort(r, {}, &trace_event::thread);
+  return r;
+}
+
+/// Discards the events recorded so far.
+///
+/// - Precondition: no thread is recording events.
+inline void clear_trace() {
+  auto& registry = detail::trace_buffers();
+  const std::lock_guard lock(registry.mutex);
+  for (const auto& b : registry.buffers)
+    b->recorded.store(0, std::memory_order_relaxed);
+}
+
+/// Writes `events` to `os` in the Chrome trace event format, for `chrome://tracing` or Perfetto.
+inline void write_chrome_trace(std::ostream& os, const std::vector<trace_event>& events) {
+  os << "{\"traceEvents\":[";
+  const char* separator = "\n";
+  for (const trace_event& e : events) {
+    os << separator << "{\"name\":";
+    detail::write_json_string(os, e.name);
+    os << ",\"ph\":\"" << (e.complete ? 'X' : 'i') << '"';
+    os << ",\"ts\":" << e.start_ns / 1000 << '.' << e.start_ns / 100 % 10 << e.start_ns / 10 % 10
+       << e.start_ns % 10;
+    if (e.complete) {
+      os << ",\"dur\":" << e.duration_ns / 1000 << '.' << e.duration_ns / 100 % 10
+         << e.duration_ns / 10 % 10 << e.duration_ns % 10;
+    } else {
+      os << ",\"s\":\"t\"";
+    }
+    os << ",\"pid\":1,\"tid\":" << e.thread << ",\"args\":{";
+    const char* argument_separator = "";
+    for (const trace_argument& a : e.arguments) {
+      if (a.name == nullptr)
+        continue;
+      os << argument_separator;
+      detail::write_json_string(os, a.name);
+      os << ':' << a.value;
+      argument_separator = ",";
+    }
+    os << "}}";
+    separator = ",\n";
+  }
+  os << "\n]}\n";
+}
+
+/// Writes the events kept in all the thread buffers to `os` in the Chrome trace event format.
+inline void write_chrome_trace(std::ostream& os) { write_chrome_trace(os, collect_trace()); }
+
+} // namespace positionless
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "positionless/detail/precondition.hpp"
+#include "positionless/detail/trace.hpp"
+#include "positionless/partitioning.hpp"
+
+#include <concepts>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+namespace positionless {
+
+/// `true` if `R`, the result of an algorithm run on a range of `Iterator`s, denotes a position:
+/// an iterator.
+template <typename R, typename Iterator>
+concept position_result = std::convertible_to<R, Iterator>;
+
+/// `true` if `R`, the result of an algorithm run on a range of `Iterator`s, denotes a subrange:
+/// e.g. a `std::ranges::subrange<Iterator>`.
+template <typename R, typename Iterator>
+concept subrange_result = !position_result<R, Iterator> && std::ranges::common_range<R> &&
+                          std::convertible_to<std::ranges::iterator_t<R>, Iterator>;
+
+/// Returns the `i`th part of `p` as a range.
+///
+/// - Precondition: `i < p.parts_count()`
+template <std::forward_iterator Iterator>
+inline std::ranges::subrange<Iterator> part_range(const partitioning<Iterator>& p, size_t i) {
+  PRECONDITION(i < p.parts_count());
+  const auto [first, last] = p.part(i);
+  return {first, last};
+}
+
+/// Splits the `i`th part of `p` at `position`, making [position, end) the new part `i + 1`.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Precondition: `position` is in the `i`th part, or is its end
+/// - Complexity: O(p.parts_count() - i) for random access iterators; O(n) otherwise, where `n` is
+///   the distance from the beginning of the part to `position`.
+template <std::forward_iterator Iterator>
+inline void split_at(partitioning<Iterator>& p, size_t i, Iterator position) {
+  PRECONDITION(i < p.parts_count());
+  const Iterator first = p.part(i).first;
+  p.add_part_begin(i);
+  p.grow_by(i, static_cast<size_t>(std::distance(first, position)));
+}
+
+/// Splits the `i`th part of `p` around [first, last), making it the new part `i + 1` and
+/// [last, end) the new part `i + 2`.
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Precondition: [first, last) is a subrange of the `i`th part
+/// - Complexity: O(p.parts_count() - i) for random access iterators; O(n) otherwise, where `n` is
+///   the distance from the beginning of the part to `last`.
+template <std::forward_iterator Iterator>
+inline void split_around(partitioning<Iterator>& p, size_t i, Iterator first, Iterator last) {
+  PRECONDITION(i < p.parts_count());
+  const Iterator begin = p.part(i).first;
+  const auto prefix = static_cast<size_t>(std::distance(begin, first));
+  const auto middle = static_cast<size_t>(std::distance(first, last));
+  // Parts grow by taking elements from the next part, so the new parts grow from the last.
+  p.add_parts_begin(i, 2);
+  p.grow_by(i + 1, prefix + middle);
+  p.grow_by(i, prefix);
+}
+
+/// Runs `algorithm` on the `i`th part of `p`, followed by `args`, and splits the part at its
+/// result.
+///
+/// If `algorithm` returns an iterator (e.g. `std::ranges::find_if`, `std::ranges::partition_point`
+/// or `std::ranges::min_element`), the part is split in two at it, as with `split_at`. If it
+/// returns a subrange (e.g. `std::ranges::partition`, `std::ranges::search` or
+/// `std::ranges::unique`), the part is split in three around it, as with `split_around`. Either
+/// way, the result starts part `i + 1`.
+///
+///     // Even numbers in part 0, odd numbers in part 1, and an empty part 2.
+///     split_by(p, 0, std::ranges::partition, is_even);
+///
+/// - Precondition: `i < p.parts_count()`
+/// - Complexity: that of `algorithm`, plus that of `split_at` or `split_around`.
+template <std::forward_iterator Iterator, typename Algorithm, typename... Args>
+  requires std::invocable<Algorithm, std::ranges::subrange<Iterator>, Args...>
+inline void split_by(partitioning<Iterator>& p, size_t i, Algorithm&& algorithm, Args&&... args) {
+  PRECONDITION(i < p.parts_count());
+  POSITIONLESS_TRACE_SCOPE("split_by", {"part", i});
+
+  using result = std::invoke_result_t<Algorithm, std::ranges::subrange<Iterator>, Args...>;
+  static_assert(
+      position_result<result, Iterator> || subrange_result<result, Iterator>,
+      "the algorithm must return an iterator or a subrange of the part"
+  );
+
+  auto r = std::invoke(
+      std::forward<Algorithm>(algorithm), part_range(p, i), std::forward<Args>(args)...
+  );
+  if constexpr (position_result<result, Iterator>) {
+    split_at(p, i, Iterator(r));
+  } else {
+    split_around(p, i, Iterator(std::ranges::begin(r)), Iterator(std::ranges::end(r)));
+  }
+}
+
+} // namespace positionless
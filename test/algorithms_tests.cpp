@@ -3,9 +3,14 @@
 #include "detail/rapidcheck_wrapper.hpp"
 #include "detail/vector_partitioning.hpp"
 
+#include <list>
 #include <vector>
 
+using positionless::merge_parts;
+using positionless::merge_with_next;
 using positionless::partitioning;
+using positionless::sort_part;
+using positionless::split_runs;
 using positionless::swap_first;
 
 TEST_PROPERTY(
@@ -218,3 +223,122 @@ TEST_PROPERTY(
       RC_ASSERT(new_rest_of_j == rest_of_j);
     }
 );
+
+TEST_PROPERTY("`split_runs` splits a part into its sorted runs", [](vector_partitioning<int> vp) {
+  const auto i = *rc::gen::inRange<size_t>(0, vp.partitioning_.parts_count());
+  const size_t k = vp.partitioning_.parts_count();
+  const auto original_data = vp.data_;
+
+  const size_t runs = split_runs(vp.partitioning_, i);
+
+  RC_ASSERT(vp.partitioning_.parts_count() == k + runs - 1);
+  RC_ASSERT(vp.data_ == original_data);
+  for (size_t r = i; r < i + runs; ++r) {
+    const auto part = vp.partitioning_.part(r);
+    RC_ASSERT(std::is_sorted(part.first, part.second));
+    // Runs are maximal.
+    if (r + 1 < i + runs) {
+      const auto next = vp.partitioning_.part(r + 1);
+      RC_ASSERT(part.first != part.second);
+      RC_ASSERT(*next.first < *std::prev(part.second));
+    }
+  }
+})
+
+TEST_PROPERTY("`merge_with_next` merges two sorted parts", [](vector_partitioning<int> vp) {
+  const size_t k = vp.partitioning_.parts_count();
+  RC_PRE(k >= size_t{2});
+  const auto i = *rc::gen::inRange<size_t>(0, k - 1);
+  for (size_t j : {i, i + 1}) {
+    const auto part = vp.partitioning_.part(j);
+    std::sort(part.first, part.second);
+  }
+  const auto first = vp.partitioning_.part(i).first;
+  const auto last = vp.partitioning_.part(i + 1).second;
+  std::vector<int> expected(first, last);
+  std::sort(expected.begin(), expected.end());
+
+  merge_with_next(vp.partitioning_, i);
+
+  RC_ASSERT(vp.partitioning_.parts_count() == k - 1);
+  const auto merged = vp.partitioning_.part(i);
+  RC_ASSERT(std::vector<int>(merged.first, merged.second) == expected);
+})
+
+TEST_PROPERTY("`sort_part` sorts only the given part", [](vector_partitioning<int> vp) {
+  const size_t k = vp.partitioning_.parts_count();
+  const auto i = *rc::gen::inRange<size_t>(0, k);
+  std::vector<std::vector<int>> expected;
+  for (size_t j = 0; j < k; ++j) {
+    const auto part = vp.partitioning_.part(j);
+    expected.emplace_back(part.first, part.second);
+  }
+  std::sort(expected[i].begin(), expected[i].end());
+
+  sort_part(vp.partitioning_, i);
+
+  RC_ASSERT(vp.partitioning_.parts_count() == k);
+  for (size_t j = 0; j < k; ++j) {
+    const auto part = vp.partitioning_.part(j);
+    RC_ASSERT(std::vector<int>(part.first, part.second) == expected[j]);
+  }
+})
+
+TEST_PROPERTY("`sort_part` works on bidirectional iterators", [](std::list<int> data) {
+  auto expected = std::vector<int>(data.begin(), data.end());
+  std::sort(expected.begin(), expected.end(), std::greater<>{});
+  partitioning<std::list<int>::iterator> p(data.begin(), data.end());
+
+  sort_part(p, 0, std::greater<>{});
+
+  RC_ASSERT(p.parts_count() == size_t{1});
+  RC_ASSERT(std::vector<int>(data.begin(), data.end()) == expected);
+})
+
+TEST_PROPERTY("`merge_parts` merges any number of sorted parts", [](vector_partitioning<int> vp) {
+  const size_t k = vp.partitioning_.parts_count();
+  const auto i = *rc::gen::inRange<size_t>(0, k);
+  const auto runs = *rc::gen::inRange<size_t>(1, k - i + 1);
+  for (size_t j = i; j < i + runs; ++j) {
+    const auto part = vp.partitioning_.part(j);
+    std::sort(part.first, part.second);
+  }
+  std::vector<int> expected(
+      vp.partitioning_.part(i).first, vp.partitioning_.part(i + runs - 1).second
+  );
+  std::sort(expected.begin(), expected.end());
+
+  merge_parts(vp.partitioning_, i, runs);
+
+  RC_ASSERT(vp.partitioning_.parts_count() == k - runs + 1);
+  const auto merged = vp.partitioning_.part(i);
+  RC_ASSERT(std::vector<int>(merged.first, merged.second) == expected);
+})
+
+/// An element with a key and its original position, for checking stability.
+using keyed_element = std::pair<int, size_t>;
+
+TEST_PROPERTY("`sort_part` is stable", [](std::vector<int> keys) {
+  std::vector<keyed_element> data;
+  for (size_t k = 0; k < keys.size(); ++k)
+    data.emplace_back(keys[k] % 4, k);
+  const auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+  auto expected = data;
+  std::stable_sort(expected.begin(), expected.end(), by_key);
+  partitioning<std::vector<keyed_element>::iterator> p(data.begin(), data.end());
+
+  sort_part(p, 0, by_key);
+
+  RC_ASSERT(data == expected);
+})
+
+TEST_CASE("`sort_part` sorts long reversed and sorted sequences with few runs") {
+  std::vector<int> data(1000);
+  for (size_t k = 0; k < data.size(); ++k)
+    data[k] = static_cast<int>(data.size() - k);
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+
+  CHECK(sort_part(p, 0) == 1);
+  CHECK(std::is_sorted(data.begin(), data.end()));
+  CHECK(sort_part(p, 0) == 1);
+}
@@ -0,0 +1,218 @@
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/records.hpp"
+#include "positionless/segments.hpp"
+#include "positionless/translation.hpp"
+
+#include "detail/allocation_tracking.hpp"
+#include "detail/rapidcheck_wrapper.hpp"
+#include "detail/vector_partitioning.hpp"
+
+#include <algorithm>
+#include <list>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using positionless::part_index;
+using positionless::partitioning;
+
+TEST_CASE("constructing a partitioning allocates its boundaries once") {
+  std::vector<int> data(100);
+  allocation_scope scope;
+  {
+    partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+    const auto constructed = scope.counts();
+    CHECK(constructed.allocations == 1);
+    CHECK(constructed.deallocations == 0);
+  }
+  CHECK(scope.counts().deallocations == 1);
+}
+
+TEST_PROPERTY("adding reserved parts does not allocate", [](std::vector<int> data) {
+  const auto k = *rc::gen::inRange<size_t>(1, 100);
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.reserve_parts(k);
+
+  allocation_scope scope;
+  p.add_parts_end(0, (k - 1) / 2);
+  while (p.parts_count() < k)
+    p.add_part_begin(p.parts_count() - 1);
+  const size_t allocations = scope.allocations();
+
+  RC_ASSERT(allocations == size_t{0});
+})
+
+TEST_PROPERTY("resizing the parts of a 2-part layout does not allocate", [](std::vector<int> data) {
+  RC_PRE(!data.empty());
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.add_part_begin(0);
+  const auto n = *rc::gen::inRange<size_t>(1, data.size() + 1);
+
+  allocation_scope scope;
+  p.grow_by(0, n);
+  p.shrink_by(0, n / 2);
+  if (!p.is_part_empty(1))
+    positionless::swap_first(p, 0, 1);
+  p.transfer_to_next(0);
+  p.transfer_to_prev(1);
+  auto h = p.with_parts<2>();
+  h.shrink_by(part_index<0>{}, data.size());
+  h.grow_by(part_index<0>{}, data.size() / 2);
+  const size_t allocations = scope.allocations();
+
+  RC_ASSERT(allocations == size_t{0});
+})
+
+TEST_PROPERTY("`split_lines` allocates the boundaries at most once", [](std::string text) {
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+
+  allocation_scope scope;
+  positionless::split_lines(p, 0);
+  const size_t allocations = scope.allocations();
+
+  RC_ASSERT(allocations <= size_t{1});
+})
+
+TEST_PROPERTY("`split_runs` allocates nothing beyond reserved parts", [](std::vector<int> data) {
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.reserve_parts(data.size() + 1);
+
+  allocation_scope scope;
+  positionless::split_runs(p, 0);
+  const size_t allocations = scope.allocations();
+
+  RC_ASSERT(allocations == size_t{0});
+})
+
+TEST_PROPERTY(
+    "`merge_with_next` allocates at most one buffer, and frees it",
+    [](std::vector<int> data) {
+      RC_PRE(data.size() >= size_t{2});
+      const auto middle = data.begin() + *rc::gen::inRange<ptrdiff_t>(1, data.size());
+      std::sort(data.begin(), middle);
+      std::sort(middle, data.end());
+      partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+      p.add_part_begin(0);
+      p.grow_by(0, static_cast<size_t>(middle - data.begin()));
+
+      allocation_scope scope;
+      positionless::merge_with_next(p, 0);
+      const auto counts = scope.counts();
+
+      RC_ASSERT(counts.allocations <= size_t{1});
+      RC_ASSERT(counts.deallocations == counts.allocations);
+    }
+)
+
+TEST_PROPERTY(
+    "partitioning a part into a 2-part layout does not allocate", [](std::vector<int> data) {
+      const auto is_even = [](int x) { return x % 2 == 0; };
+      partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+      p.reserve_parts(2);
+
+      allocation_scope scope;
+      positionless::partition_part(p, 0, is_even);
+      const size_t allocations = scope.allocations();
+
+      RC_ASSERT(allocations == size_t{0});
+      RC_ASSERT(p.parts_count() == size_t{2});
+    }
+)
+
+TEST_PROPERTY(
+    "`split_by` with `std::ranges::partition` allocates nothing beyond reserved parts",
+    [](std::vector<int> data) {
+      const auto is_even = [](int x) { return x % 2 == 0; };
+      partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+      p.reserve_parts(3);
+
+      allocation_scope scope;
+      positionless::split_by(p, 0, std::ranges::partition, is_even);
+      const size_t allocations = scope.allocations();
+
+      RC_ASSERT(allocations == size_t{0});
+      RC_ASSERT(p.parts_count() == size_t{3});
+    }
+)
+
+TEST_PROPERTY(
+    "`merge_parts` allocates at most one buffer per merge, and frees them",
+    [](std::vector<int> data) {
+      partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+      p.reserve_parts(data.size() + 1);
+      const size_t runs = positionless::split_runs(p, 0);
+
+      allocation_scope scope;
+      positionless::merge_parts(p, 0, runs);
+      const auto counts = scope.counts();
+
+      RC_ASSERT(counts.allocations <= runs - 1);
+      RC_ASSERT(counts.deallocations == counts.allocations);
+      RC_ASSERT(counts.bytes <= counts.allocations * data.size() * sizeof(int));
+    }
+)
+
+TEST_PROPERTY(
+    "`sort_part` allocates at most one buffer per merge beyond reserved parts, and frees them",
+    [](std::vector<int> data) {
+      partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+      p.reserve_parts(data.size() + 1);
+
+      allocation_scope scope;
+      const size_t runs = positionless::sort_part(p, 0);
+      const auto counts = scope.counts();
+
+      RC_ASSERT(counts.allocations <= runs - 1);
+      RC_ASSERT(counts.deallocations == counts.allocations);
+      RC_ASSERT(counts.bytes <= counts.allocations * data.size() * sizeof(int));
+    }
+)
+
+TEST_CASE("`sort_part` of a large part allocates one buffer per merge at most") {
+  std::vector<int> data(10000);
+  for (size_t k = 0; k < data.size(); ++k)
+    data[k] = static_cast<int>((k * 7919) % 10007);
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.reserve_parts(data.size() + 1);
+
+  allocation_scope scope;
+  const size_t runs = positionless::sort_part(p, 0);
+  const auto counts = scope.counts();
+
+  CHECK(runs > 1);
+  CHECK(counts.allocations <= runs - 1);
+  CHECK(counts.deallocations == counts.allocations);
+  CHECK(std::is_sorted(data.begin(), data.end()));
+}
+
+TEST_PROPERTY(
+    "`sort_part` does not allocate through the resource of the sorted list",
+    [](std::vector<int> values) {
+      counting_memory_resource resource;
+      std::pmr::list<int> data(values.begin(), values.end(), &resource);
+      const allocation_counts before = resource.counts();
+      partitioning<std::pmr::list<int>::iterator> p(data.begin(), data.end());
+      p.reserve_parts(values.size() + 1);
+
+      allocation_scope scope;
+      const size_t runs = positionless::sort_part(p, 0);
+      const auto counts = scope.counts();
+
+      RC_ASSERT(resource.counts() == before);
+      RC_ASSERT(counts.allocations <= runs - 1);
+      RC_ASSERT(counts.deallocations == counts.allocations);
+      RC_ASSERT(std::is_sorted(data.begin(), data.end()));
+    }
+)
+
+TEST_CASE("`counting_memory_resource` counts allocations") {
+  counting_memory_resource resource;
+  {
+    std::pmr::vector<int> v(&resource);
+    v.reserve(10);
+    CHECK(resource.counts().allocations == 1);
+    CHECK(resource.counts().bytes == 10 * sizeof(int));
+  }
+  CHECK(resource.counts().deallocations == 1);
+}
@@ -0,0 +1,59 @@
+#include "positionless/async_loader.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using positionless::async_file_loader;
+
+namespace {
+
+/// A file with given contents in the temporary directory, removed on destruction.
+struct temporary_file {
+  std::filesystem::path path_;
+
+  explicit temporary_file(const std::string& contents)
+      : path_(std::filesystem::temp_directory_path() / "positionless_async_loader_test.bin") {
+    std::ofstream(path_, std::ios::binary) << contents;
+  }
+
+  ~temporary_file() { std::filesystem::remove(path_); }
+};
+
+} // namespace
+
+TEST_PROPERTY(
+    "`async_file_loader` loads the whole file, growing part 0",
+    [](std::vector<char> data) {
+      const std::string contents(data.begin(), data.end());
+      temporary_file file(contents);
+      const auto chunk_size = *rc::gen::inRange<size_t>(1, 16);
+      const auto threads = *rc::gen::inRange<size_t>(1, 5);
+
+      async_file_loader loader(file.path_, chunk_size, threads);
+      RC_ASSERT(loader.file_size() == contents.size());
+      RC_ASSERT(loader.parts().parts_count() == size_t{2});
+
+      size_t loaded = 0;
+      while (loader.wait_for_more()) {
+        const auto part = loader.parts().part(0);
+        RC_ASSERT(static_cast<size_t>(part.second - part.first) > loaded);
+        loaded = static_cast<size_t>(part.second - part.first);
+        RC_ASSERT(std::string(part.first, part.second) == contents.substr(0, loaded));
+      }
+      RC_ASSERT(loaded == contents.size());
+      RC_ASSERT(loader.parts().is_part_empty(1));
+    }
+)
+
+TEST_CASE("`async_file_loader` can be destroyed before loading completes") {
+  temporary_file file(std::string(1 << 16, 'x'));
+  async_file_loader loader(file.path_, 64, 2);
+  CHECK(loader.parts().parts_count() == 2);
+}
+
+TEST_CASE("`async_file_loader` throws for missing files") {
+  CHECK_THROWS_AS(async_file_loader("/nonexistent/positionless/file"), std::system_error);
+}
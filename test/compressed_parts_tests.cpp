@@ -0,0 +1,88 @@
+#include "positionless/compressed_parts.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+#include "detail/vector_partitioning.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+using positionless::compressed_parts;
+
+TEST_PROPERTY(
+    "`compressed_parts` restores the contents of each part",
+    [](vector_partitioning<int> vp) {
+      std::vector<uint32_t> data(vp.data_.begin(), vp.data_.end());
+      positionless::partitioning<std::vector<uint32_t>::iterator> p(data.begin(), data.end());
+      for (size_t i = 0; i + 1 < vp.partitioning_.parts_count(); ++i) {
+        p.add_part_begin(i);
+        p.grow_by(i, vp.partitioning_.part_size(i));
+      }
+
+      const compressed_parts<uint32_t> c(p);
+
+      RC_ASSERT(c.parts_count() == p.parts_count());
+      for (size_t i = 0; i < p.parts_count(); ++i) {
+        const auto part = p.part(i);
+        RC_ASSERT(c.part_size(i) == p.part_size(i));
+        RC_ASSERT(c.part(i) == std::vector<uint32_t>(part.first, part.second));
+      }
+    }
+)
+
+TEST_PROPERTY("`compressed_parts` supports 64-bit values of any width", [](std::vector<bool> bits) {
+  std::vector<uint64_t> data;
+  uint64_t x = 0x9e3779b97f4a7c15ull;
+  for (bool b : bits) {
+    x = x * 6364136223846793005ull + 1442695040888963407ull;
+    const auto width = static_cast<unsigned>(x >> 58);
+    data.push_back(b ? x >> (63 - width) : std::numeric_limits<uint64_t>::max());
+  }
+  positionless::partitioning<std::vector<uint64_t>::iterator> p(data.begin(), data.end());
+
+  const compressed_parts<uint64_t> c(p);
+
+  RC_ASSERT(c.part(0) == data);
+})
+
+TEST_CASE("`compressed_parts` stores sorted data compactly") {
+  std::vector<uint64_t> data(10000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = 1000000 + 3 * i;
+  positionless::partitioning<std::vector<uint64_t>::iterator> p(data.begin(), data.end());
+  p.add_part_begin(0);
+  p.grow_by(0, 5000);
+
+  const compressed_parts<uint64_t> c(p);
+
+  CHECK(c.compressed_bytes() < data.size() * sizeof(uint64_t) / 16);
+  std::vector<uint64_t> decoded;
+  c.decode_part(1, std::back_inserter(decoded));
+  CHECK(decoded == std::vector<uint64_t>(data.begin() + 5000, data.end()));
+}
+
+TEST_CASE("`compressed_parts` decodes blocks of differences of every width") {
+  for (unsigned width = 1; width <= 64; ++width) {
+    // 3 blocks of differences and a partial one, the largest difference having `width` bits.
+    std::vector<uint64_t> data(3 * 64 + 20);
+    uint64_t x = width;
+    for (size_t i = 1; i < data.size(); ++i) {
+      x = x * 6364136223846793005ull + 1442695040888963407ull;
+      const uint64_t delta = i == 100 ? ~uint64_t{0} >> (64 - width) : x >> (64 - width);
+      data[i] = data[i - 1] + delta;
+    }
+    positionless::partitioning<std::vector<uint64_t>::iterator> p(data.begin(), data.end());
+    p.add_part_begin(0);
+    p.grow_by(0, 1);
+
+    const compressed_parts<uint64_t> c(p);
+
+    CHECK(c.part(1) == std::vector<uint64_t>(data.begin() + 1, data.end()));
+    if (width <= 32) {
+      std::vector<uint32_t> narrow(data.begin(), data.end());
+      positionless::partitioning<std::vector<uint32_t>::iterator> q(narrow.begin(), narrow.end());
+      CHECK(compressed_parts<uint32_t>(q).part(0) == narrow);
+    }
+  }
+}
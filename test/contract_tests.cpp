@@ -0,0 +1,37 @@
+// Built as the separate `contract_tests` executable, with `POSITIONLESS_CONTRACT_LEVEL` off.
+#include "positionless/detail/precondition.hpp"
+
+#include <doctest/doctest.h>
+
+static_assert(POSITIONLESS_CONTRACT_LEVEL == POSITIONLESS_CONTRACT_OFF);
+
+namespace {
+
+/// Returns `true`, counting the calls in `evaluations`.
+bool counted(int& evaluations) {
+  ++evaluations;
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("disabled preconditions do not evaluate their expressions") {
+  int evaluations = 0;
+
+  PRECONDITION(counted(evaluations));
+  EXPENSIVE_PRECONDITION(counted(evaluations));
+  AUDIT_PRECONDITION(counted(evaluations));
+
+  CHECK(evaluations == 0);
+}
+
+TEST_CASE("disabled preconditions do not check their expressions") {
+  const bool violated = false;
+
+  PRECONDITION(violated);
+  EXPENSIVE_PRECONDITION(violated);
+  AUDIT_PRECONDITION(violated);
+
+  // Reaching this point means that no check failed.
+  CHECK_FALSE(violated);
+}
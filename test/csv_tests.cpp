@@ -0,0 +1,125 @@
+#include "positionless/csv.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <string>
+#include <vector>
+
+using positionless::csv_field;
+using positionless::partitioning;
+using positionless::split_csv_fields;
+using positionless::split_csv_rows;
+
+namespace {
+
+/// A CSV field, as generated for tests.
+struct csv_cell {
+  /// The field's contents.
+  std::string text_;
+  /// `true` if the field is quoted.
+  bool quoted_;
+};
+
+/// Returns CSV text for `rows`, each row terminated by a newline.
+std::string to_csv(const std::vector<std::vector<csv_cell>>& rows) {
+  std::string r;
+  for (const auto& row : rows) {
+    for (size_t j = 0; j < row.size(); ++j) {
+      if (j != 0)
+        r += ',';
+      r += row[j].quoted_ ? '"' + row[j].text_ + '"' : row[j].text_;
+    }
+    r += '\n';
+  }
+  return r;
+}
+
+/// Returns random rows, where quoted fields may contain delimiters and newlines.
+std::vector<std::vector<csv_cell>> arbitrary_rows(size_t max_rows) {
+  const auto n = *rc::gen::inRange<size_t>(0, max_rows);
+  std::vector<std::vector<csv_cell>> rows(n);
+  for (auto& row : rows) {
+    row.resize(*rc::gen::inRange<size_t>(1, 6));
+    for (auto& cell : row) {
+      cell.quoted_ = *rc::gen::inRange(0, 2) == 1;
+      const auto length = *rc::gen::inRange<size_t>(0, 6);
+      for (size_t k = 0; k < length; ++k) {
+        const auto c = *rc::gen::inRange(0, cell.quoted_ ? 4 : 2);
+        cell.text_ += "ab,\n"[c];
+      }
+    }
+    // An empty unquoted single field would be an empty line.
+    if (row.size() == 1 && row[0].text_.empty())
+      row[0].quoted_ = true;
+  }
+  return rows;
+}
+
+/// Checks that splitting `text` into rows and fields yields `rows`.
+void check_split(
+    const std::string& text, const std::vector<std::vector<csv_cell>>& rows, size_t threads
+) {
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+  split_csv_rows(p, threads);
+
+  RC_ASSERT(p.parts_count() == std::max<size_t>(rows.size(), 1));
+  for (size_t i = 0; i < rows.size(); ++i) {
+    const auto [first, last] = p.part(i);
+    partitioning<const char*> row(first, last);
+    RC_ASSERT(split_csv_fields(row, 0) == rows[i].size());
+    RC_ASSERT(row.parts_count() == rows[i].size());
+    for (size_t j = 0; j < rows[i].size(); ++j)
+      RC_ASSERT(csv_field(row.part(j)) == rows[i][j].text_);
+  }
+}
+
+} // namespace
+
+TEST_PROPERTY("`split_csv_rows` and `split_csv_fields` find all rows and fields", []() {
+  const auto rows = arbitrary_rows(20);
+  check_split(to_csv(rows), rows, 1);
+})
+
+TEST_PROPERTY("`split_csv_rows` finds the same rows with multiple threads", []() {
+  auto rows = arbitrary_rows(20);
+  // Make the data large enough to be scanned in several chunks.
+  while (to_csv(rows).size() < 5 * 4096) {
+    const auto more = arbitrary_rows(200);
+    rows.insert(rows.end(), more.begin(), more.end());
+  }
+  check_split(to_csv(rows), rows, *rc::gen::inRange<size_t>(2, 6));
+})
+
+TEST_CASE("`split_csv_rows` keeps a final row without newline") {
+  const std::string text = "a,b\nc,d";
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+  split_csv_rows(p);
+
+  REQUIRE(p.parts_count() == 2);
+  CHECK(std::string(p.part(0).first, p.part(0).second) == "a,b\n");
+  CHECK(std::string(p.part(1).first, p.part(1).second) == "c,d");
+}
+
+TEST_CASE("`split_csv_fields` splits a row in the middle of a partitioning") {
+  const std::string text = "x\n\"1,2\",3\r\ny\n";
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+  split_csv_rows(p);
+  REQUIRE(p.parts_count() == 3);
+
+  CHECK(split_csv_fields(p, 1) == 2);
+  REQUIRE(p.parts_count() == 4);
+  CHECK(csv_field(p.part(0)) == "x");
+  CHECK(csv_field(p.part(1)) == "1,2");
+  CHECK(csv_field(p.part(2)) == "3");
+  CHECK(csv_field(p.part(3)) == "y");
+}
+
+TEST_CASE("`split_csv_fields` supports TSV") {
+  const std::string text = "a\tb c\t\n";
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+
+  CHECK(split_csv_fields(p, 0, '\t') == 3);
+  CHECK(csv_field(p.part(0), '\t') == "a");
+  CHECK(csv_field(p.part(1), '\t') == "b c");
+  CHECK(csv_field(p.part(2), '\t') == "");
+}
@@ -0,0 +1,93 @@
+// Replacements of the global allocation functions, counting the calls of each thread.
+#include "allocation_tracking.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+allocation_counts& this_thread_allocation_counts() noexcept {
+  thread_local allocation_counts counts;
+  return counts;
+}
+
+namespace {
+
+/// Allocates `size` bytes aligned to `alignment`, counting the allocation; returns `nullptr` on
+/// failure.
+///
+/// The size of the allocation, and the offset of the returned pointer in the underlying block, are
+/// stored just before the returned pointer, so that deallocations can count the freed bytes.
+void* counted_allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept {
+  const size_t header = std::max(alignment, alignof(std::max_align_t));
+  static_assert(alignof(std::max_align_t) >= 2 * sizeof(size_t));
+  const size_t total = header + (size == 0 ? 1 : size);
+  void* block = alignment <= alignof(std::max_align_t)
+                    ? std::malloc(total)
+                    : std::aligned_alloc(alignment, (total + alignment - 1) / alignment * alignment);
+  if (block == nullptr)
+    return nullptr;
+  auto* r = static_cast<char*>(block) + header;
+  reinterpret_cast<size_t*>(r)[-1] = header;
+  reinterpret_cast<size_t*>(r)[-2] = size;
+  allocation_counts& counts = this_thread_allocation_counts();
+  ++counts.allocations;
+  counts.bytes += size;
+  return r;
+}
+
+/// Like `counted_allocate`, but throws `std::bad_alloc` on failure.
+void* counted_allocate_or_throw(size_t size, size_t alignment = alignof(std::max_align_t)) {
+  void* r = counted_allocate(size, alignment);
+  if (r == nullptr)
+    throw std::bad_alloc();
+  return r;
+}
+
+/// Frees `p`, counting the deallocation if `p` is not null.
+void counted_free(void* p) noexcept {
+  if (p == nullptr)
+    return;
+  const size_t header = static_cast<size_t*>(p)[-1];
+  allocation_counts& counts = this_thread_allocation_counts();
+  ++counts.deallocations;
+  counts.freed_bytes += static_cast<size_t*>(p)[-2];
+  std::free(static_cast<char*>(p) - header);
+}
+
+} // namespace
+
+void* operator new(size_t size) { return counted_allocate_or_throw(size); }
+void* operator new[](size_t size) { return counted_allocate_or_throw(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return counted_allocate(size); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+  return counted_allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return counted_allocate_or_throw(size, static_cast<size_t>(alignment));
+}
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return counted_allocate(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return counted_allocate(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, size_t) noexcept { counted_free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { counted_free(p); }
+void operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+  counted_free(p);
+}
+void operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept {
+  counted_free(p);
+}
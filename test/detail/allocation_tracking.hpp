@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+/// The numbers of dynamic memory allocations and deallocations, and of bytes allocated and freed.
+struct allocation_counts {
+  size_t allocations{0};
+  size_t deallocations{0};
+  size_t bytes{0};
+  size_t freed_bytes{0};
+
+  /// Returns the number of bytes allocated and not freed.
+  ///
+  /// Only meaningful for memory allocated and freed by the same thread.
+  ptrdiff_t live_bytes() const noexcept {
+    return static_cast<ptrdiff_t>(bytes) - static_cast<ptrdiff_t>(freed_bytes);
+  }
+
+  bool operator==(const allocation_counts&) const = default;
+};
+
+/// Returns the counts of the calls of the global `operator new` and `operator delete` made by the
+/// calling thread.
+///
+/// Defined with the replacements of the global allocation functions, in
+/// `allocation_tracking.cpp`.
+allocation_counts& this_thread_allocation_counts() noexcept;
+
+/// Measures the global allocations made by the calling thread during the lifetime of the instance.
+class allocation_scope {
+public:
+  /// An instance starting the measurement.
+  allocation_scope() noexcept : start_(this_thread_allocation_counts()) {}
+
+  /// Returns the counts since the construction of `this`.
+  allocation_counts counts() const noexcept {
+    const allocation_counts& now = this_thread_allocation_counts();
+    return {
+        now.allocations - start_.allocations,
+        now.deallocations - start_.deallocations,
+        now.bytes - start_.bytes,
+        now.freed_bytes - start_.freed_bytes
+    };
+  }
+
+  /// Returns the number of allocations since the construction of `this`.
+  size_t allocations() const noexcept { return counts().allocations; }
+
+private:
+  /// The counts at construction.
+  allocation_counts start_;
+};
+
+/// A memory resource counting the allocations made through it, and forwarding them to an upstream
+/// resource.
+class counting_memory_resource : public std::pmr::memory_resource {
+public:
+  /// An instance forwarding to `upstream`.
+  explicit counting_memory_resource(
+      std::pmr::memory_resource* upstream = std::pmr::get_default_resource()
+  ) noexcept
+      : upstream_(upstream) {}
+
+  /// Returns the counts of the allocations made through `this`.
+  const allocation_counts& counts() const noexcept { return counts_; }
+
+private:
+  void* do_allocate(size_t bytes, size_t alignment) override {
+    void* r = upstream_->allocate(bytes, alignment);
+    ++counts_.allocations;
+    counts_.bytes += bytes;
+    return r;
+  }
+
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+    ++counts_.deallocations;
+    counts_.freed_bytes += bytes;
+    upstream_->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+
+  /// The resource doing the allocations.
+  std::pmr::memory_resource* upstream_;
+  /// The counts of the allocations made through `this`.
+  allocation_counts counts_{};
+};
@@ -0,0 +1,192 @@
+#include "positionless/execution.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+#include "detail/vector_partitioning.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using positionless::for_each_part;
+using positionless::merge_parts;
+using positionless::partitioning;
+using positionless::reduce_parts;
+using positionless::sort_part;
+using positionless::split_runs;
+namespace execution = positionless::execution;
+
+namespace {
+
+/// An element sorted by `key` only, to check stability.
+using keyed_element = std::pair<int, size_t>;
+
+/// Returns `n` elements with random keys in [0, keys), numbered in order.
+std::vector<keyed_element> random_elements(size_t n, int keys) {
+  std::mt19937 rng(static_cast<std::mt19937::result_type>(n));
+  std::uniform_int_distribution<int> key(0, keys - 1);
+  std::vector<keyed_element> r(n);
+  for (size_t k = 0; k < n; ++k)
+    r[k] = {key(rng), k};
+  return r;
+}
+
+/// Compares elements by key.
+bool key_less(const keyed_element& a, const keyed_element& b) { return a.first < b.first; }
+
+/// The sizes exercising both the sequential and the parallel paths.
+constexpr size_t sizes[] = {0, 1, 100, 3 * positionless::detail::min_parallel_chunk + 17,
+                            40 * positionless::detail::min_parallel_chunk};
+
+} // namespace
+
+TEST_CASE("`parallel_for` runs each task once") {
+  for (size_t threads : {1, 2, 8}) {
+    std::vector<std::atomic<int>> calls(100);
+    positionless::detail::parallel_for(calls.size(), [&](size_t t) { ++calls[t]; }, threads);
+    CHECK(std::ranges::all_of(calls, [](const auto& c) { return c == 1; }));
+  }
+}
+
+namespace {
+
+/// A `std::thread` whose construction fails after `started_limit` threads were started.
+struct failing_thread : std::thread {
+  static inline size_t started_limit = 0;
+  static inline size_t started = 0;
+
+  template <typename F> explicit failing_thread(F&& f) : std::thread(spawn(std::forward<F>(f))) {}
+
+  template <typename F> static std::thread spawn(F&& f) {
+    if (started == started_limit)
+      throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again));
+    ++started;
+    return std::thread(std::forward<F>(f));
+  }
+};
+
+} // namespace
+
+TEST_CASE("`parallel_for` runs all the tasks when threads cannot be started") {
+  for (size_t limit : {0, 1, 2}) {
+    failing_thread::started_limit = limit;
+    failing_thread::started = 0;
+    std::vector<std::atomic<int>> calls(100);
+    positionless::detail::parallel_for<failing_thread>(
+        calls.size(), [&](size_t t) { ++calls[t]; }, 8
+    );
+    CHECK(failing_thread::started == limit);
+    CHECK(std::ranges::all_of(calls, [](const auto& c) { return c == 1; }));
+  }
+}
+
+TEST_CASE("`parallel_for` rethrows the exceptions of the tasks") {
+  const auto f = [](size_t t) {
+    if (t == 3)
+      throw std::runtime_error("task 3");
+  };
+  CHECK_THROWS_AS(positionless::detail::parallel_for(10, f, 4), std::runtime_error);
+}
+
+TEST_CASE("`sort_part` with a parallel policy is a stable sort") {
+  for (size_t n : sizes) {
+    for (int keys : {2, 1000}) {
+      auto data = random_elements(n, keys);
+      auto expected = data;
+      std::ranges::stable_sort(expected, key_less);
+
+      partitioning<std::vector<keyed_element>::iterator> p(data.begin(), data.end());
+      sort_part(execution::par, p, 0, key_less);
+
+      CHECK(p.parts_count() == 1);
+      CHECK(data == expected);
+    }
+  }
+}
+
+TEST_CASE("`sort_part` with a parallel policy sorts lists sequentially") {
+  const auto data = random_elements(1000, 10);
+  std::list<keyed_element> l(data.begin(), data.end());
+  partitioning<std::list<keyed_element>::iterator> p(l.begin(), l.end());
+
+  sort_part(execution::par_unseq, p, 0, key_less);
+
+  CHECK(std::ranges::is_sorted(l, key_less));
+}
+
+TEST_CASE("`split_runs` with a parallel policy splits like the sequential version") {
+  for (size_t n : sizes) {
+    auto data = random_elements(n, 1000);
+    // Lengthen the runs, so that some of them span chunks.
+    for (size_t k = 0; k + 64 <= n; k += 64) {
+      const auto run = data.begin() + static_cast<ptrdiff_t>(k);
+      std::sort(run, run + 64, key_less);
+    }
+
+    partitioning<std::vector<keyed_element>::iterator> sequential(data.begin(), data.end());
+    partitioning<std::vector<keyed_element>::iterator> parallel(data.begin(), data.end());
+    const size_t runs = split_runs(execution::seq, sequential, 0, key_less);
+
+    CHECK(split_runs(execution::par, parallel, 0, key_less) == runs);
+    REQUIRE(parallel.parts_count() == sequential.parts_count());
+    for (size_t j = 0; j < runs; ++j)
+      CHECK(parallel.part(j) == sequential.part(j));
+  }
+}
+
+TEST_CASE("`merge_parts` with a parallel policy merges the parts into one") {
+  for (size_t n : sizes) {
+    auto data = random_elements(n, 100);
+    auto expected = data;
+    std::ranges::stable_sort(expected, key_less);
+
+    partitioning<std::vector<keyed_element>::iterator> p(data.begin(), data.end());
+    const size_t runs = split_runs(p, 0, key_less);
+    merge_parts(execution::par, p, 0, runs, key_less);
+
+    CHECK(p.parts_count() == 1);
+    CHECK(data == expected);
+  }
+}
+
+TEST_PROPERTY(
+    "`for_each_part` with a parallel policy visits each part once",
+    [](vector_partitioning<int> vp) {
+      const auto& p = vp.partitioning_;
+      std::atomic<size_t> calls{0};
+      std::atomic<size_t> elements{0};
+      for_each_part(execution::par, p, [&](auto part) {
+        ++calls;
+        elements += static_cast<size_t>(part.second - part.first);
+      });
+      RC_ASSERT(calls == p.parts_count());
+      RC_ASSERT(elements == vp.data_.size());
+    }
+)
+
+TEST_PROPERTY(
+    "`reduce_parts` with a parallel policy folds the parts in order",
+    [](vector_partitioning<int> vp) {
+      const auto& p = vp.partitioning_;
+      // Concatenating part sizes is associative but not commutative.
+      const auto concatenate = [](std::vector<size_t> a, const std::vector<size_t>& b) {
+        a.insert(a.end(), b.begin(), b.end());
+        return a;
+      };
+      const auto size = [](auto part) {
+        return std::vector<size_t>{static_cast<size_t>(part.second - part.first)};
+      };
+
+      const auto expected = reduce_parts(p, std::vector<size_t>{}, concatenate, size);
+      RC_ASSERT(
+          reduce_parts(execution::par, p, std::vector<size_t>{}, concatenate, size) == expected
+      );
+      RC_ASSERT(expected.size() == p.parts_count());
+    }
+)
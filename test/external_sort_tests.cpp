@@ -0,0 +1,122 @@
+#include "positionless/external_sort.hpp"
+
+#include "detail/allocation_tracking.hpp"
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using positionless::external_sort;
+
+namespace {
+
+/// The paths of an input and an output file in the temporary directory, removed on destruction.
+struct temporary_files {
+  std::filesystem::path input_{
+      std::filesystem::temp_directory_path() / "positionless_external_sort_in.bin"
+  };
+  std::filesystem::path output_{
+      std::filesystem::temp_directory_path() / "positionless_external_sort_out.bin"
+  };
+
+  ~temporary_files() {
+    std::filesystem::remove(input_);
+    std::filesystem::remove(output_);
+  }
+};
+
+/// Writes `data` to the file at `path`.
+void write_file(const std::filesystem::path& path, const std::vector<int>& data) {
+  std::ofstream(path, std::ios::binary)
+      .write(
+          reinterpret_cast<const char*>(data.data()),
+          static_cast<std::streamsize>(data.size() * sizeof(int))
+      );
+}
+
+/// Returns the `int`s stored in the file at `path`.
+std::vector<int> read_file(const std::filesystem::path& path) {
+  std::vector<int> r(std::filesystem::file_size(path) / sizeof(int));
+  const auto bytes = static_cast<std::streamsize>(r.size() * sizeof(int));
+  std::ifstream(path, std::ios::binary).read(reinterpret_cast<char*>(r.data()), bytes);
+  return r;
+}
+
+} // namespace
+
+TEST_PROPERTY("`external_sort` sorts the elements of a file", [](std::vector<int> data) {
+  temporary_files files;
+  write_file(files.input_, data);
+  const auto budget = *rc::gen::inRange<size_t>(1, 12) * sizeof(int);
+
+  const auto stats = external_sort<int>(files.input_, files.output_, budget);
+
+  std::sort(data.begin(), data.end());
+  RC_ASSERT(read_file(files.output_) == data);
+
+  size_t total = 0;
+  for (size_t i = 0; i < stats.chunk_sizes.size(); ++i) {
+    RC_ASSERT(stats.chunk_sizes[i] <= budget / sizeof(int));
+    RC_ASSERT(stats.chunk_runs[i] >= size_t{1});
+    RC_ASSERT(stats.chunk_runs[i] <= stats.chunk_sizes[i]);
+    total += stats.chunk_sizes[i];
+  }
+  RC_ASSERT(total == data.size());
+})
+
+TEST_CASE("`external_sort` supports custom comparisons") {
+  temporary_files files;
+  std::vector<int> data(1000);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<int>((i * 7919) % 1000);
+  write_file(files.input_, data);
+
+  const auto stats =
+      external_sort<int>(files.input_, files.output_, 64 * sizeof(int), std::greater<>{});
+
+  std::sort(data.begin(), data.end(), std::greater<>{});
+  CHECK(read_file(files.output_) == data);
+  CHECK(stats.chunk_sizes.size() == 16);
+}
+
+TEST_CASE("`external_sort` rejects files holding a partial element") {
+  temporary_files files;
+  std::ofstream(files.input_, std::ios::binary) << "0123456";
+
+  CHECK_THROWS_AS(
+      external_sort<int>(files.input_, files.output_, 64 * sizeof(int)), std::runtime_error
+  );
+}
+
+TEST_CASE("`external_sort` throws for missing files") {
+  temporary_files files;
+  CHECK_THROWS_AS(
+      external_sort<int>(files.input_, files.output_, 64 * sizeof(int)), std::ios_base::failure
+  );
+}
+
+TEST_CASE("`external_sort` frees its chunk before merging the runs") {
+  temporary_files files;
+  constexpr size_t budget = size_t{1} << 20;
+  std::vector<int> data(3 * budget / sizeof(int));
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<int>((i * 7919) % data.size());
+  write_file(files.input_, data);
+
+  allocation_scope scope;
+  // The memory in use at the last comparison, which is made by the merge of the runs.
+  ptrdiff_t live_bytes = 0;
+  const auto comp = [&](int a, int b) {
+    live_bytes = scope.counts().live_bytes();
+    return a < b;
+  };
+  const auto stats = external_sort<int>(files.input_, files.output_, budget, comp);
+
+  REQUIRE(stats.chunk_sizes.size() == 3);
+  CHECK(live_bytes < static_cast<ptrdiff_t>(budget / 2));
+  std::sort(data.begin(), data.end());
+  CHECK(read_file(files.output_) == data);
+}
@@ -0,0 +1,135 @@
+#include "positionless/instrumented.hpp"
+
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <sstream>
+#include <vector>
+
+using positionless::counting_predicate;
+using positionless::instrumented_iterator;
+using positionless::make_counting_predicate;
+using positionless::make_instrumented;
+using positionless::operation_counts;
+using positionless::partitioning;
+
+static_assert(std::random_access_iterator<instrumented_iterator<std::vector<int>::iterator>>);
+static_assert(std::random_access_iterator<instrumented_iterator<int*>>);
+static_assert(std::bidirectional_iterator<instrumented_iterator<std::list<int>::iterator>>);
+static_assert(!std::random_access_iterator<instrumented_iterator<std::list<int>::iterator>>);
+static_assert(std::forward_iterator<instrumented_iterator<std::forward_list<int>::iterator>>);
+static_assert(
+    !std::bidirectional_iterator<instrumented_iterator<std::forward_list<int>::iterator>>
+);
+
+TEST_PROPERTY(
+    "`grow_by` walks the boundary one element at a time for forward iterators",
+    []() {
+      const auto n = *rc::gen::inRange<size_t>(0, 1000);
+      std::forward_list<int> data(n);
+      operation_counts counts;
+      partitioning<instrumented_iterator<std::forward_list<int>::iterator>> p(
+          make_instrumented(data.begin(), counts), make_instrumented(data.end(), counts)
+      );
+      p.add_part_begin(0);
+      counts.reset();
+
+      p.grow_by(0, n);
+
+      RC_ASSERT(counts.increments == n);
+      RC_ASSERT(counts.jumps == size_t{0});
+      RC_ASSERT(counts.dereferences == size_t{0});
+    }
+)
+
+TEST_CASE("`grow_by` jumps to the new boundary for random access iterators") {
+  std::vector<int> data(1000);
+  operation_counts counts;
+  partitioning<instrumented_iterator<std::vector<int>::iterator>> p(
+      make_instrumented(data.begin(), counts), make_instrumented(data.end(), counts)
+  );
+  p.add_part_begin(0);
+  counts.reset();
+
+  p.grow_by(0, 1000);
+
+  CHECK(counts.increments == 0);
+  CHECK(counts.jumps == 1);
+  CHECK(p.part_size(0) == 1000);
+}
+
+TEST_CASE("`swap_first` swaps through `iter_swap`") {
+  std::vector<int> data{1, 2, 3, 4};
+  operation_counts counts;
+  partitioning<instrumented_iterator<std::vector<int>::iterator>> p(
+      make_instrumented(data.begin(), counts), make_instrumented(data.end(), counts)
+  );
+  p.add_part_begin(0);
+  p.grow_by(0, 2);
+  counts.reset();
+
+  positionless::swap_first(p, 0, 1);
+
+  CHECK(data == std::vector<int>{3, 2, 1, 4});
+  CHECK(counts.swaps == 1);
+}
+
+TEST_PROPERTY("`counting_predicate` counts each call", [](std::vector<int> data) {
+  operation_counts counts;
+  const auto less = make_counting_predicate(counts, std::less<>{});
+  const auto is_sorted = std::is_sorted(data.begin(), data.end(), less);
+
+  RC_ASSERT(is_sorted == std::is_sorted(data.begin(), data.end()));
+  RC_ASSERT(counts.comparisons <= (data.empty() ? size_t{0} : data.size() - 1));
+  RC_ASSERT(counts.total() == counts.comparisons);
+})
+
+TEST_PROPERTY("`sort_part` with instrumented iterators sorts", [](std::vector<int> data) {
+  std::list<int> values(data.begin(), data.end());
+  operation_counts counts;
+  partitioning<instrumented_iterator<std::list<int>::iterator>> p(
+      make_instrumented(values.begin(), counts), make_instrumented(values.end(), counts)
+  );
+
+  positionless::sort_part(p, 0, counting_predicate<std::less<>>(counts));
+
+  std::sort(data.begin(), data.end());
+  RC_ASSERT(std::vector<int>(values.begin(), values.end()) == data);
+  RC_ASSERT(counts.jumps == size_t{0});
+  RC_ASSERT(data.size() < 2 || counts.comparisons > size_t{0});
+})
+
+TEST_CASE("`operation_counts` reports, accumulates and subtracts counts") {
+  operation_counts a;
+  a.increments = 3;
+  a.comparisons = 2;
+  operation_counts b = a;
+  b += a;
+
+  CHECK(b.increments == 6);
+  CHECK(b.total() == 10);
+  CHECK(b - a == a);
+
+  std::ostringstream os;
+  os << a;
+  CHECK(os.str() == a.report());
+  CHECK(a.report().find("increments:   3\n") != std::string::npos);
+  CHECK(a.report().find("comparisons:  2\n") != std::string::npos);
+}
+
+TEST_CASE("default-constructed `instrumented_iterator`s do not count") {
+  std::vector<int> data{1, 2};
+  instrumented_iterator<std::vector<int>::iterator> i;
+  CHECK(i.counts() == nullptr);
+  operation_counts counts;
+  i = make_instrumented(data.begin(), counts);
+  ++i;
+  CHECK(*i == 2);
+  CHECK(counts.increments == 1);
+  CHECK(counts.dereferences == 1);
+}
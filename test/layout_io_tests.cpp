@@ -0,0 +1,72 @@
+#include "positionless/layout_io.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+#include "detail/vector_partitioning.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using positionless::load_layout;
+using positionless::save_layout;
+
+TEST_PROPERTY(
+    "`load_layout` restores the layout written by `save_layout`",
+    [](vector_partitioning<int> vp) {
+      std::stringstream s;
+      save_layout(vp.partitioning_, s);
+
+      const auto p = load_layout(vp.data_.begin(), vp.data_.end(), s);
+
+      RC_ASSERT(p.parts_count() == vp.partitioning_.parts_count());
+      for (size_t i = 0; i < p.parts_count(); ++i)
+        RC_ASSERT(p.part(i) == vp.partitioning_.part(i));
+    }
+)
+
+TEST_PROPERTY("`load_layout` rejects corrupted layouts", [](vector_partitioning<int> vp) {
+  std::stringstream s;
+  save_layout(vp.partitioning_, s);
+  std::string bytes = s.str();
+
+  const auto i = *rc::gen::inRange<size_t>(0, bytes.size());
+  const auto flip = *rc::gen::inRange<int>(1, 256);
+  bytes[i] = static_cast<char>(bytes[i] ^ flip);
+
+  std::istringstream in(bytes);
+  bool thrown = false;
+  try {
+    (void)load_layout(vp.data_.begin(), vp.data_.end(), in);
+  } catch (const std::runtime_error&) {
+    thrown = true;
+  }
+  RC_ASSERT(thrown);
+})
+
+TEST_CASE("`load_layout` rejects layouts of ranges with a different size") {
+  std::vector<int> data(10);
+  positionless::partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.add_part_begin(0);
+  p.grow_by(0, 3);
+
+  std::stringstream s;
+  save_layout(p, s);
+
+  CHECK_THROWS_AS(load_layout(data.begin(), data.end() - 1, s), std::runtime_error);
+}
+
+TEST_CASE("`load_layout` rejects truncated layouts") {
+  std::vector<int> data(300);
+  positionless::partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.add_part_begin(0);
+  p.grow_by(0, 200);
+
+  std::stringstream s;
+  save_layout(p, s);
+  const std::string bytes = s.str();
+
+  for (size_t n = 0; n < bytes.size(); ++n) {
+    std::istringstream in(bytes.substr(0, n));
+    CHECK_THROWS_AS(load_layout(data.begin(), data.end(), in), std::runtime_error);
+  }
+}
@@ -0,0 +1,220 @@
+#include "positionless/list_algorithms.hpp"
+
+#include "detail/partitioning_generators.hpp"
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+using positionless::list_partitioning;
+using positionless::splice_merge_with_next;
+using positionless::splice_part;
+using positionless::splice_partition;
+using positionless::splice_sort_part;
+
+namespace {
+
+/// A list of `int`s.
+using int_list = std::list<int>;
+
+/// Returns the elements of each part of `p`.
+std::vector<std::vector<int>> contents(const list_partitioning<int_list>& p) {
+  std::vector<std::vector<int>> r;
+  for (size_t i = 0; i < p.parts_count(); ++i)
+    r.emplace_back(p.part(i).first, p.part(i).second);
+  return r;
+}
+
+/// Returns the concatenation of `parts`.
+std::vector<int> concatenation(const std::vector<std::vector<int>>& parts) {
+  std::vector<int> r;
+  for (const auto& part : parts)
+    r.insert(r.end(), part.begin(), part.end());
+  return r;
+}
+
+/// Returns the address and value of each element of `l`.
+std::vector<std::pair<const int*, int>> elements_in_memory(const int_list& l) {
+  std::vector<std::pair<const int*, int>> r;
+  for (const int& x : l)
+    r.emplace_back(&x, x);
+  return r;
+}
+
+/// Returns `true` if each element recorded in `before` still holds its value, i.e., no element was
+/// moved in memory.
+bool not_moved(const std::vector<std::pair<const int*, int>>& before) {
+  return std::ranges::all_of(before, [](const auto& e) { return *e.first == e.second; });
+}
+
+/// Returns `true` if the parts of `p` cover `l` exactly, in order.
+bool covers(const list_partitioning<int_list>& p, const int_list& l) {
+  return p.part(0).first == l.begin() && p.part(p.parts_count() - 1).second == l.end() &&
+         concatenation(contents(p)) == std::vector<int>(l.begin(), l.end());
+}
+
+} // namespace
+
+TEST_PROPERTY("`splice_partition` partitions a part stably", [](const std::vector<int>& data) {
+  int_list l(data.begin(), data.end());
+  list_partitioning<int_list> p(l.begin(), l.end());
+  testgen::generate_splits(p);
+  const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count());
+  const auto before = contents(p);
+  const auto memory = elements_in_memory(l);
+  const auto is_even = [](int x) { return x % 2 == 0; };
+
+  splice_partition(l, p, i, is_even);
+
+  auto expected = before;
+  auto& part = expected[i];
+  const auto odd = std::ranges::stable_partition(part, is_even);
+  std::vector<int> odd_elements(odd.begin(), odd.end());
+  part.erase(odd.begin(), odd.end());
+  expected.insert(expected.begin() + static_cast<ptrdiff_t>(i) + 1, odd_elements);
+  RC_ASSERT(contents(p) == expected);
+  RC_ASSERT(covers(p, l));
+  RC_ASSERT(not_moved(memory));
+})
+
+TEST_PROPERTY("`splice_merge_with_next` merges sorted parts", [](const std::vector<int>& data) {
+  int_list l(data.begin(), data.end());
+  list_partitioning<int_list> p(l.begin(), l.end());
+  testgen::generate_splits(p);
+  RC_PRE(p.parts_count() >= size_t{2});
+  const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count() - 1);
+  for (size_t j = 0; j < p.parts_count(); ++j)
+    splice_sort_part(l, p, j);
+  const auto before = contents(p);
+  const auto memory = elements_in_memory(l);
+
+  splice_merge_with_next(l, p, i);
+
+  auto expected = before;
+  std::vector<int> merged;
+  std::ranges::merge(before[i], before[i + 1], std::back_inserter(merged));
+  expected[i] = merged;
+  expected.erase(expected.begin() + static_cast<ptrdiff_t>(i) + 1);
+  RC_ASSERT(contents(p) == expected);
+  RC_ASSERT(covers(p, l));
+  RC_ASSERT(not_moved(memory));
+})
+
+TEST_PROPERTY("`splice_sort_part` sorts a part", [](const std::vector<int>& data) {
+  int_list l(data.begin(), data.end());
+  list_partitioning<int_list> p(l.begin(), l.end());
+  testgen::generate_splits(p);
+  const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count());
+  auto expected = contents(p);
+  const auto memory = elements_in_memory(l);
+
+  splice_sort_part(l, p, i);
+
+  std::ranges::sort(expected[i]);
+  RC_ASSERT(contents(p) == expected);
+  RC_ASSERT(covers(p, l));
+  RC_ASSERT(not_moved(memory));
+})
+
+TEST_PROPERTY("`splice_part` moves a part", [](const std::vector<int>& data) {
+  int_list l(data.begin(), data.end());
+  list_partitioning<int_list> p(l.begin(), l.end());
+  testgen::generate_splits(p);
+  const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count());
+  const size_t j = *rc::gen::inRange<size_t>(0, p.parts_count());
+  auto expected = contents(p);
+  const auto memory = elements_in_memory(l);
+
+  splice_part(l, p, i, j);
+
+  auto moved = std::move(expected[i]);
+  expected.erase(expected.begin() + static_cast<ptrdiff_t>(i));
+  expected.insert(expected.begin() + static_cast<ptrdiff_t>(j), std::move(moved));
+  RC_ASSERT(contents(p) == expected);
+  RC_ASSERT(covers(p, l));
+  RC_ASSERT(not_moved(memory));
+})
+
+TEST_CASE("`splice_partition` keeps the iterators of a part's elements valid") {
+  int_list l{5, 2, 7, 4, 1};
+  list_partitioning<int_list> p(l.begin(), l.end());
+  const auto seven = std::next(l.begin(), 2);
+
+  splice_partition(l, p, 0, [](int x) { return x < 3; });
+
+  REQUIRE(p.parts_count() == 2);
+  CHECK(contents(p) == std::vector<std::vector<int>>{{2, 1}, {5, 7, 4}});
+  CHECK(*seven == 7);
+  CHECK(std::next(seven) == std::prev(l.end()));
+}
+
+namespace {
+
+/// Thrown by `throwing_less`.
+struct comparison_failure {};
+
+/// A comparison of `int`s throwing on its `n`th call.
+struct throwing_less {
+  std::shared_ptr<size_t> calls = std::make_shared<size_t>(0);
+  size_t n;
+
+  bool operator()(int a, int b) const {
+    if (++*calls == n)
+      throw comparison_failure{};
+    return a < b;
+  }
+};
+
+/// Returns the elements of `p`'s parts as one sorted vector.
+std::vector<int> sorted_elements(const list_partitioning<int_list>& p) {
+  auto r = concatenation(contents(p));
+  std::ranges::sort(r);
+  return r;
+}
+
+} // namespace
+
+TEST_PROPERTY(
+    "list algorithms keep a valid layout when comparisons throw",
+    [](std::vector<int> data) {
+      int_list l(data.begin(), data.end());
+      list_partitioning<int_list> p(l.begin(), l.end());
+      testgen::generate_splits(p);
+      RC_PRE(p.parts_count() >= size_t{2});
+      const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count() - 1);
+      const throwing_less comp{.n = *rc::gen::inRange<size_t>(1, data.size() + 2)};
+      std::ranges::sort(data);
+      const size_t parts = p.parts_count();
+
+      try {
+        splice_sort_part(l, p, i, comp);
+      } catch (const comparison_failure&) {
+      }
+      RC_ASSERT(p.parts_count() == parts);
+      RC_ASSERT(covers(p, l));
+      RC_ASSERT(sorted_elements(p) == data);
+
+      splice_sort_part(l, p, i);
+      splice_sort_part(l, p, i + 1);
+      *comp.calls = 0;
+      try {
+        splice_merge_with_next(l, p, i, comp);
+      } catch (const comparison_failure&) {
+      }
+      RC_ASSERT(p.parts_count() == parts - 1);
+      RC_ASSERT(covers(p, l));
+      RC_ASSERT(sorted_elements(p) == data);
+
+      *comp.calls = 0;
+      try {
+        splice_partition(l, p, i, [&](int x) { return comp(x, 0); });
+      } catch (const comparison_failure&) {
+      }
+      RC_ASSERT(covers(p, l));
+      RC_ASSERT(sorted_elements(p) == data);
+    }
+)
@@ -0,0 +1,64 @@
+#include "positionless/mapped_file.hpp"
+#include "positionless/records.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using positionless::mapped_file_partitioning;
+
+namespace {
+
+/// A file with given contents in the temporary directory, removed on destruction.
+struct temporary_file {
+  std::filesystem::path path_;
+
+  explicit temporary_file(const std::string& contents)
+      : path_(std::filesystem::temp_directory_path() / "positionless_mapped_file_test.txt") {
+    std::ofstream(path_, std::ios::binary) << contents;
+  }
+
+  ~temporary_file() { std::filesystem::remove(path_); }
+};
+
+} // namespace
+
+TEST_CASE("`mapped_file_partitioning` covers the file contents with a single part") {
+  const std::string contents = "first line\nsecond line\n";
+  temporary_file file(contents);
+
+  mapped_file_partitioning p(file.path_);
+
+  REQUIRE(p.parts_count() == 1);
+  CHECK(p.file_size() == contents.size());
+  auto [begin, end] = p.part(0);
+  CHECK(std::string(begin, end) == contents);
+}
+
+TEST_CASE("`mapped_file_partitioning` supports empty files") {
+  temporary_file file("");
+
+  mapped_file_partitioning p(file.path_);
+
+  CHECK(p.parts_count() == 1);
+  CHECK(p.is_part_empty(0));
+}
+
+TEST_CASE("`mapped_file_partitioning` throws for missing files") {
+  CHECK_THROWS_AS(mapped_file_partitioning("/nonexistent/positionless/file"), std::system_error);
+}
+
+TEST_CASE("`mapped_file_partitioning` can be split at records") {
+  temporary_file file("one\ntwo\nthree\nfour\nfive\n");
+
+  mapped_file_partitioning p(file.path_);
+  positionless::split_at_records(p, 2, '\n');
+
+  REQUIRE(p.parts_count() == 2);
+  auto [b0, e0] = p.part(0);
+  auto [b1, e1] = p.part(1);
+  CHECK(std::string(b0, e0) == "one\ntwo\nthree\n");
+  CHECK(std::string(b1, e1) == "four\nfive\n");
+}
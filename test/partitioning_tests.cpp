@@ -7,6 +7,8 @@
 #include <list>
 #include <vector>
 
+using positionless::fixed_parts;
+using positionless::part_index;
 using positionless::partitioning;
 
 TEST_PROPERTY("parts of a partitioning cover the entire data", [](vector_partitioning<int> vp) {
@@ -511,3 +513,119 @@ TEST_PROPERTY(
       RC_ASSERT(p.part_size(i) == old_size - 1);
     }
 )
+
+TEST_PROPERTY("`reserve_parts` does not change the parts", [](vector_partitioning<int> vp) {
+  const size_t k = vp.partitioning_.parts_count();
+  std::vector<decltype(vp.partitioning_.part(0))> before;
+  for (size_t i = 0; i < k; ++i)
+    before.push_back(vp.partitioning_.part(i));
+
+  vp.partitioning_.reserve_parts(*rc::gen::inRange<size_t>(0, 100));
+
+  RC_ASSERT(vp.partitioning_.parts_count() == k);
+  for (size_t i = 0; i < k; ++i)
+    RC_ASSERT(vp.partitioning_.part(i) == before[i]);
+})
+
+TEST_PROPERTY("`shrink_to_fit` does not change the parts", [](vector_partitioning<int> vp) {
+  const size_t k = vp.partitioning_.parts_count();
+  std::vector<decltype(vp.partitioning_.part(0))> before;
+  for (size_t i = 0; i < k; ++i)
+    before.push_back(vp.partitioning_.part(i));
+  const size_t old_footprint = vp.partitioning_.memory_footprint();
+
+  vp.partitioning_.shrink_to_fit();
+
+  RC_ASSERT(vp.partitioning_.memory_footprint() <= old_footprint);
+  RC_ASSERT(vp.partitioning_.parts_count() == k);
+  for (size_t i = 0; i < k; ++i)
+    RC_ASSERT(vp.partitioning_.part(i) == before[i]);
+})
+
+TEST_CASE("`memory_footprint` includes the reserved boundaries") {
+  using iterator = std::vector<int>::iterator;
+  std::vector<int> c(10);
+  partitioning<iterator> p(c.begin(), c.end());
+  const size_t exact = sizeof(p) + 2 * sizeof(iterator);
+  CHECK(p.memory_footprint() == exact);
+
+  p.reserve_parts(8);
+  CHECK(p.memory_footprint() >= sizeof(p) + 9 * sizeof(iterator));
+
+  p.shrink_to_fit();
+  CHECK(p.memory_footprint() == exact);
+}
+
+/// A handle to 3 parts of a vector of `int`s.
+using three_parts = fixed_parts<std::vector<int>::iterator, 3>;
+
+/// `true` if part `I` of `Handle` can be accessed.
+template <typename Handle, size_t I>
+concept can_access_part = requires(Handle h) { h.part(part_index<I>{}); };
+
+/// `true` if part `I` of `Handle` can grow.
+template <typename Handle, size_t I>
+concept can_grow_part = requires(Handle h) { h.grow_by(part_index<I>{}, 1); };
+
+/// `true` if part `I` of `Handle` can shrink.
+template <typename Handle, size_t I>
+concept can_shrink_part = requires(Handle h) { h.shrink_by(part_index<I>{}, 1); };
+
+/// `true` if part `I` of `Handle` can be transferred to the previous part.
+template <typename Handle, size_t I>
+concept can_transfer_to_prev = requires(Handle h) { h.transfer_to_prev(part_index<I>{}); };
+
+static_assert(three_parts::parts_count() == 3);
+static_assert(can_access_part<three_parts, 2>);
+static_assert(!can_access_part<three_parts, 3>);
+static_assert(can_grow_part<three_parts, 1>);
+static_assert(!can_grow_part<three_parts, 2>);
+static_assert(can_shrink_part<three_parts, 1>);
+static_assert(!can_shrink_part<fixed_parts<std::forward_list<int>::iterator, 3>, 1>);
+static_assert(can_transfer_to_prev<three_parts, 2>);
+static_assert(!can_transfer_to_prev<three_parts, 0>);
+
+TEST_PROPERTY("`with_parts` resizes parts like the partitioning does", [](std::vector<int> data) {
+  std::vector<int> copy = data;
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  partitioning<std::vector<int>::iterator> expected(copy.begin(), copy.end());
+  for (auto* q : {&p, &expected})
+    q->add_parts_begin(0, 2);
+  const auto n = *rc::gen::inRange<size_t>(0, data.size() + 1);
+  const auto m = *rc::gen::inRange<size_t>(0, n + 1);
+
+  auto h = p.with_parts<3>();
+  h.grow_by(part_index<1>{}, n);
+  h.grow_by(part_index<0>{}, m);
+  h.shrink_by(part_index<0>{}, m / 2);
+  expected.grow_by(1, n);
+  expected.grow_by(0, m);
+  expected.shrink_by(0, m / 2);
+
+  size_t total = 0;
+  h.for_each_part([&](auto i) {
+    RC_ASSERT(h.part_size(i) == expected.part_size(i));
+    RC_ASSERT(h.is_part_empty(i) == expected.is_part_empty(i));
+    RC_ASSERT(h.part(i) == p.part(i));
+    total += h.part_size(i);
+  });
+  RC_ASSERT(total == data.size());
+})
+
+TEST_CASE("`with_parts` transfers parts") {
+  std::list<int> data{1, 2, 3, 4, 5};
+  partitioning<std::list<int>::iterator> p(data.begin(), data.end());
+  p.add_parts_begin(0, 2);
+  auto h = p.with_parts<3>();
+  h.grow_by(part_index<1>{}, 3);
+  h.grow_by(part_index<0>{}, 1);
+
+  h.transfer_to_next(part_index<0>{});
+  CHECK(h.part_size(part_index<0>{}) == 0);
+  CHECK(h.part_size(part_index<1>{}) == 3);
+
+  h.transfer_to_prev(part_index<2>{});
+  CHECK(h.part_size(part_index<1>{}) == 5);
+  CHECK(p.part_size(1) == 5);
+  CHECK(p.is_part_empty(2));
+}
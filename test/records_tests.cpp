@@ -0,0 +1,238 @@
+#include "positionless/records.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <forward_list>
+#include <string>
+#include <vector>
+
+using positionless::partitioning;
+using positionless::split_at_records;
+
+/// Returns a text with a newline for each `true` in `line_ends`, and a letter for each `false`.
+static std::vector<char> as_text(const std::vector<bool>& line_ends) {
+  std::vector<char> r;
+  for (bool is_end : line_ends)
+    r.push_back(is_end ? '\n' : 'x');
+  return r;
+}
+
+TEST_PROPERTY(
+    "`split_at_records` creates the requested number of parts, covering the data",
+    [](std::vector<bool> line_ends) {
+      std::vector<char> data = as_text(line_ends);
+      const auto n_parts = *rc::gen::inRange<size_t>(1, 10);
+
+      partitioning<std::vector<char>::iterator> p(data.begin(), data.end());
+      split_at_records(p, n_parts, '\n');
+
+      RC_ASSERT(p.parts_count() == n_parts);
+      size_t sum = 0;
+      for (size_t i = 0; i < p.parts_count(); ++i)
+        sum += p.part_size(i);
+      RC_ASSERT(sum == data.size());
+    }
+)
+
+TEST_PROPERTY(
+    "`split_at_records` makes parts end with a delimiter, at the end of the data, or be empty",
+    [](std::vector<bool> line_ends) {
+      std::vector<char> data = as_text(line_ends);
+      const auto n_parts = *rc::gen::inRange<size_t>(1, 10);
+
+      partitioning<std::vector<char>::iterator> p(data.begin(), data.end());
+      split_at_records(p, n_parts, '\n');
+
+      for (size_t i = 0; i + 1 < p.parts_count(); ++i) {
+        const auto part = p.part(i);
+        RC_ASSERT(
+            (part.first == part.second || part.second == data.end() ||
+             *std::prev(part.second) == '\n')
+        );
+      }
+    }
+)
+
+TEST_PROPERTY(
+    "`split_at_records` creates parts of roughly equal size",
+    [](std::vector<bool> line_ends) {
+      std::vector<char> data = as_text(line_ends);
+      const auto n_parts = *rc::gen::inRange<size_t>(1, 10);
+
+      partitioning<std::vector<char>::iterator> p(data.begin(), data.end());
+      split_at_records(p, n_parts, '\n');
+
+      // Each boundary is at the first record start after its even position.
+      size_t boundary = 0;
+      for (size_t i = 0; i + 1 < p.parts_count(); ++i) {
+        boundary += p.part_size(i);
+        const size_t target = data.size() * (i + 1) / n_parts;
+        if (boundary > target) {
+          RC_ASSERT(target > 0);
+          const auto from = data.begin() + static_cast<ptrdiff_t>(target - 1);
+          const auto to = data.begin() + static_cast<ptrdiff_t>(boundary - 1);
+          RC_ASSERT(std::find(from, to, '\n') == to);
+        } else {
+          RC_ASSERT((target == 0 || boundary == target || p.is_part_empty(i)));
+        }
+      }
+    }
+)
+
+TEST_CASE("`split_at_records` works on forward iterators") {
+  const std::string text = "a\nbb\nccc\ndddd\n";
+  std::forward_list<char> data(text.begin(), text.end());
+
+  partitioning<std::forward_list<char>::iterator> p(data.begin(), data.end());
+  split_at_records(p, 3, '\n');
+
+  REQUIRE(p.parts_count() == 3);
+  CHECK(p.part_size(0) == 5);
+  CHECK(p.part_size(1) == 4);
+  CHECK(p.part_size(2) == 5);
+}
+
+TEST_PROPERTY("`split_lines` creates one part per line", [](std::vector<bool> line_ends) {
+  std::vector<char> data = as_text(line_ends);
+  std::string text(data.begin(), data.end());
+
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+  p.add_part_begin(0);
+  p.grow_by(0, *rc::gen::inRange<size_t>(0, text.size() + 1));
+  p.add_part_end(1);
+  const size_t before = p.part_size(0);
+
+  const size_t lines = positionless::split_lines(p, 1);
+
+  RC_ASSERT(p.parts_count() == lines + 2);
+  RC_ASSERT(p.part_size(0) == before);
+  RC_ASSERT(p.is_part_empty(lines + 1));
+  std::string rebuilt;
+  for (size_t k = 1; k <= lines; ++k) {
+    const auto line = std::string(p.part(k).first, p.part(k).second);
+    const auto newline = line.find('\n');
+    RC_ASSERT((newline == std::string::npos || newline + 1 == line.size()));
+    if (k < lines)
+      RC_ASSERT(newline != std::string::npos);
+    rebuilt += line;
+  }
+  RC_ASSERT(rebuilt == text.substr(before));
+})
+
+TEST_CASE("`split_lines` handles text with and without a final newline") {
+  const std::string text = "a\n\nbc\nd";
+  std::forward_list<char> data(text.begin(), text.end());
+  partitioning<std::forward_list<char>::iterator> p(data.begin(), data.end());
+
+  CHECK(positionless::split_lines(p, 0) == 4);
+  CHECK(p.part_size(0) == 2);
+  CHECK(p.part_size(1) == 1);
+  CHECK(p.part_size(2) == 3);
+  CHECK(p.part_size(3) == 1);
+
+  const std::string terminated = "a\nb\n";
+  partitioning<const char*> q(terminated.data(), terminated.data() + terminated.size());
+  CHECK(positionless::split_lines(q, 0) == 2);
+
+  partitioning<const char*> empty(terminated.data(), terminated.data());
+  CHECK(positionless::split_lines(empty, 0) == 1);
+  CHECK(empty.parts_count() == 1);
+}
+
+TEST_PROPERTY(
+    "`split_length_prefixed` creates one part per complete record, and a trailing part",
+    [](std::vector<std::vector<char>> payloads) {
+      std::vector<char> data;
+      for (const auto& payload : payloads) {
+        data.push_back(static_cast<char>(payload.size() >> 8));
+        data.push_back(static_cast<char>(payload.size() & 0xff));
+        data.insert(data.end(), payload.begin(), payload.end());
+      }
+      const auto truncated = *rc::gen::inRange<size_t>(0, data.size() + 1);
+      data.resize(truncated);
+
+      partitioning<std::vector<char>::iterator> p(data.begin(), data.end());
+      const size_t records =
+          positionless::split_length_prefixed(p, 0, positionless::fixed_length_prefix<2>{});
+
+      RC_ASSERT(p.parts_count() == records + 1);
+      size_t offset = 0;
+      for (size_t k = 0; k < records; ++k) {
+        RC_ASSERT(p.part_size(k) == payloads[k].size() + 2);
+        const auto part = p.part(k);
+        RC_ASSERT(std::vector<char>(part.first + 2, part.second) == payloads[k]);
+        offset += p.part_size(k);
+      }
+      // The trailing part is an incomplete record.
+      RC_ASSERT(offset + p.part_size(records) == data.size());
+      RC_ASSERT(
+          (records == payloads.size() || offset + payloads[records].size() + 2 > data.size())
+      );
+    }
+)
+
+TEST_CASE("`split_length_prefixed` supports little-endian headers and forward iterators") {
+  const std::string text = std::string("\x01\x00", 2) + "a" + std::string("\x02\x00", 2) + "bc" +
+                           std::string("\x05\x00", 2) + "de";
+  std::forward_list<char> data(text.begin(), text.end());
+  partitioning<std::forward_list<char>::iterator> p(data.begin(), data.end());
+
+  const size_t records = positionless::split_length_prefixed(
+      p, 0, positionless::fixed_length_prefix<2, std::endian::little>{}
+  );
+
+  CHECK(records == 2);
+  REQUIRE(p.parts_count() == 3);
+  CHECK(p.part_size(0) == 3);
+  CHECK(p.part_size(1) == 4);
+  CHECK(p.part_size(2) == 4);
+}
+
+TEST_CASE("`split_length_prefixed` rejects empty records") {
+  const std::string text = "xyz";
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+  const auto zero_size = [](const char*, const char*) { return std::optional<size_t>{0}; };
+
+  CHECK_THROWS_AS(positionless::split_length_prefixed(p, 0, zero_size), std::runtime_error);
+}
+
+TEST_CASE("`split_length_prefixed` leaves the part unsplit when it rejects a record") {
+  // Two records of 3 bytes, then one of size 0.
+  const std::string text{'\3', 'a', 'b', '\3', 'c', 'd', '\0', 'e', 'f'};
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+  const auto one_byte_length = [](const char* first, const char* last) {
+    return first == last ? std::nullopt : std::optional<size_t>{static_cast<size_t>(*first)};
+  };
+
+  CHECK_THROWS_AS(positionless::split_length_prefixed(p, 0, one_byte_length), std::runtime_error);
+  REQUIRE(p.parts_count() == 1);
+  CHECK(p.part_size(0) == text.size());
+}
+
+TEST_CASE("`split_length_prefixed` rejects lengths that overflow") {
+  const std::string text(12, '\xff');
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+
+  CHECK_THROWS_AS(
+      positionless::split_length_prefixed(p, 0, positionless::fixed_length_prefix<8>{}),
+      std::runtime_error
+  );
+  CHECK(p.parts_count() == 1);
+}
+
+namespace {
+
+/// A decoder of 4-byte headers, decoding records of 2 bytes.
+struct short_records {
+  static constexpr size_t header_size = 4;
+  std::optional<size_t> operator()(const char*, const char*) const { return 2; }
+};
+
+} // namespace
+
+TEST_CASE("`split_length_prefixed` rejects records smaller than their header") {
+  const std::string text = "wxyz";
+  partitioning<const char*> p(text.data(), text.data() + text.size());
+
+  CHECK_THROWS_AS(positionless::split_length_prefixed(p, 0, short_records{}), std::runtime_error);
+}
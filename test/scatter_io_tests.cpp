@@ -0,0 +1,75 @@
+#include "positionless/scatter_io.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+#include "detail/vector_partitioning.hpp"
+
+#include <cstdio>
+#include <vector>
+
+#include <unistd.h>
+
+using positionless::write_parts;
+using positionless::writev_parts;
+
+namespace {
+
+/// An anonymous temporary file.
+struct temporary_file {
+  std::FILE* file_{std::tmpfile()};
+
+  ~temporary_file() { std::fclose(file_); }
+
+  /// Returns the file descriptor of the file.
+  int fd() const { return ::fileno(file_); }
+
+  /// Returns the contents of the file, as `int`s.
+  std::vector<int> contents() const {
+    std::vector<int> r(static_cast<size_t>(::lseek(fd(), 0, SEEK_END)) / sizeof(int));
+    ::pread(fd(), r.data(), r.size() * sizeof(int), 0);
+    return r;
+  }
+};
+
+} // namespace
+
+TEST_PROPERTY("`writev_parts` writes all the parts, in order", [](vector_partitioning<int> vp) {
+  temporary_file file;
+
+  const size_t written = writev_parts(vp.partitioning_, file.fd());
+
+  RC_ASSERT(written == vp.data_.size() * sizeof(int));
+  RC_ASSERT(file.contents() == vp.data_);
+})
+
+TEST_PROPERTY("`write_parts` writes each part to its file", [](vector_partitioning<int> vp) {
+  temporary_file files[2];
+  std::vector<int> fds;
+  std::vector<int> expected[2];
+  for (size_t i = 0; i < vp.partitioning_.parts_count(); ++i) {
+    const auto f = *rc::gen::inRange<size_t>(0, 2);
+    fds.push_back(files[f].fd());
+    const auto part = vp.partitioning_.part(i);
+    expected[f].insert(expected[f].end(), part.first, part.second);
+  }
+
+  const size_t written = write_parts(vp.partitioning_, fds);
+
+  RC_ASSERT(written == vp.data_.size() * sizeof(int));
+  RC_ASSERT(files[0].contents() == expected[0]);
+  RC_ASSERT(files[1].contents() == expected[1]);
+})
+
+TEST_CASE("`writev_parts` writes more parts than fit in a single `writev`") {
+  std::vector<int> data(3 * positionless::detail::max_iovecs + 7);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<int>(i);
+  vector_partitioning<int> vp(data);
+  for (size_t i = 0; i + 1 < data.size(); ++i) {
+    vp.partitioning_.add_part_begin(i);
+    vp.partitioning_.grow(i);
+  }
+
+  temporary_file file;
+  CHECK(writev_parts(vp.partitioning_, file.fd()) == data.size() * sizeof(int));
+  CHECK(file.contents() == data);
+}
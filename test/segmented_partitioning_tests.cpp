@@ -0,0 +1,158 @@
+#include "positionless/segmented_partitioning.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+using positionless::for_each_segment;
+using positionless::has_contiguous_segments;
+using positionless::partition_part;
+using positionless::reduce_elements;
+using positionless::segmented_iterator;
+using positionless::segmented_partitioning;
+using positionless::sort_part;
+
+/// Pages of `int`s.
+using pages = std::vector<std::vector<int>>;
+
+static_assert(std::random_access_iterator<segmented_iterator<int>>);
+static_assert(std::random_access_iterator<segmented_iterator<const int>>);
+static_assert(has_contiguous_segments<segmented_iterator<int>>);
+
+namespace {
+
+/// Returns the concatenation of `buffers`.
+std::vector<int> concatenation(const pages& buffers) {
+  std::vector<int> r;
+  for (const auto& b : buffers)
+    r.insert(r.end(), b.begin(), b.end());
+  return r;
+}
+
+/// An element sorted by `key` only, to check stability.
+using keyed_element = std::pair<int, size_t>;
+
+/// Compares elements by key.
+bool key_less(const keyed_element& a, const keyed_element& b) { return a.first < b.first; }
+
+} // namespace
+
+TEST_PROPERTY("`segmented_partitioning` iterates the concatenation of its buffers", [](pages b) {
+  segmented_partitioning<int> p(b);
+  const auto expected = concatenation(b);
+
+  const auto first = p.part(0).first;
+  const auto last = p.part(0).second;
+  RC_ASSERT(std::vector<int>(first, last) == expected);
+  RC_ASSERT(static_cast<size_t>(last - first) == expected.size());
+  const auto non_empty = std::ranges::count_if(b, [](const auto& x) { return !x.empty(); });
+  RC_ASSERT(p.segments_count() == static_cast<size_t>(non_empty));
+
+  std::vector<int> backwards;
+  for (auto i = last; i != first;)
+    backwards.push_back(*--i);
+  std::ranges::reverse(backwards);
+  RC_ASSERT(backwards == expected);
+})
+
+TEST_PROPERTY("`segmented_iterator` jumps to any position", [](pages b) {
+  segmented_partitioning<int> p(b);
+  const auto expected = concatenation(b);
+  const auto first = p.part(0).first;
+  const auto last = p.part(0).second;
+
+  const auto from = *rc::gen::inRange<ptrdiff_t>(0, static_cast<ptrdiff_t>(expected.size()) + 1);
+  const auto to = *rc::gen::inRange<ptrdiff_t>(0, static_cast<ptrdiff_t>(expected.size()) + 1);
+  auto i = first + from;
+  i += to - from;
+  RC_ASSERT(i - first == to);
+  RC_ASSERT((i == last) == (to == static_cast<ptrdiff_t>(expected.size())));
+  if (i != last)
+    RC_ASSERT(*i == expected[static_cast<size_t>(to)]);
+  RC_ASSERT((first + from < first + to) == (from < to));
+})
+
+TEST_PROPERTY("parts of a `segmented_partitioning` span buffer edges", [](pages b) {
+  segmented_partitioning<int> p(b);
+  const auto expected = concatenation(b);
+  RC_PRE(expected.size() >= size_t{2});
+  const auto split = *rc::gen::inRange<size_t>(1, expected.size());
+
+  p.add_part_begin(0);
+  p.grow_by(0, split);
+
+  RC_ASSERT(p.part_size(0) == split);
+  RC_ASSERT(p.part_size(1) == expected.size() - split);
+  std::vector<int> second;
+  for_each_segment(p.part(1).first, p.part(1).second, [&](int* first, int* last) {
+    second.insert(second.end(), first, last);
+  });
+  const std::vector<int> expected_second(
+      expected.begin() + static_cast<ptrdiff_t>(split), expected.end()
+  );
+  RC_ASSERT(second == expected_second);
+})
+
+TEST_PROPERTY("`sort_part` sorts a `segmented_partitioning` stably", [](pages b) {
+  std::vector<std::vector<keyed_element>> keyed;
+  size_t n = 0;
+  for (const auto& page : b) {
+    keyed.emplace_back();
+    for (int x : page)
+      keyed.back().emplace_back(x % 8, n++);
+  }
+  std::vector<keyed_element> expected;
+  for (const auto& page : keyed)
+    expected.insert(expected.end(), page.begin(), page.end());
+  std::ranges::stable_sort(expected, key_less);
+
+  segmented_partitioning<keyed_element> p(keyed);
+  sort_part(p, 0, key_less);
+
+  RC_ASSERT(p.parts_count() == size_t{1});
+  RC_ASSERT(std::vector<keyed_element>(p.part(0).first, p.part(0).second) == expected);
+})
+
+TEST_CASE("segmented algorithms loop over pages") {
+  pages b(10, std::vector<int>(100));
+  for (size_t k = 0; k < b.size(); ++k)
+    std::iota(b[k].begin(), b[k].end(), static_cast<int>(k * 100));
+  segmented_partitioning<int> p(b);
+  p.add_part_begin(0);
+  p.grow_by(0, 150);
+
+  CHECK(reduce_elements(p, 0, 0L) == 149L * 150 / 2);
+  CHECK(reduce_elements(p, 1, 0L) == 999L * 1000 / 2 - 149L * 150 / 2);
+
+  partition_part(p, 1, [](int x) { return x % 3 == 0; });
+  REQUIRE(p.parts_count() == 3);
+  CHECK(p.part_size(1) == 284);
+  CHECK(std::all_of(p.part(1).first, p.part(1).second, [](int x) { return x % 3 == 0; }));
+  CHECK(std::none_of(p.part(2).first, p.part(2).second, [](int x) { return x % 3 == 0; }));
+}
+
+TEST_CASE("`segmented_partitioning` stays valid when moved") {
+  pages b{{1, 2}, {}, {3}, {4, 5, 6}};
+  segmented_partitioning<int> p(b);
+  p.add_part_begin(0);
+  p.grow_by(0, 2);
+
+  const segmented_partitioning<int> q(std::move(p));
+
+  CHECK(q.segments_count() == 3);
+  CHECK(std::vector<int>(q.part(0).first, q.part(0).second) == std::vector<int>{1, 2});
+  CHECK(std::vector<int>(q.part(1).first, q.part(1).second) == std::vector<int>{3, 4, 5, 6});
+}
+
+TEST_CASE("`segmented_partitioning` accepts read-only buffers") {
+  const std::vector<int> first_page{1, 2};
+  const std::vector<int> second_page{3};
+  const std::span<const int> buffers[] = {first_page, second_page};
+  segmented_partitioning<const int> p(buffers);
+  CHECK(reduce_elements(p, 0, 0) == 6);
+}
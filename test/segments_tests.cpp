@@ -0,0 +1,120 @@
+#include "positionless/segments.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <numeric>
+#include <vector>
+
+using positionless::for_each_element;
+using positionless::for_each_segment;
+using positionless::has_contiguous_segments;
+using positionless::partition_part;
+using positionless::partitioning;
+using positionless::reduce_elements;
+
+namespace {
+
+/// Returns the elements of [first, last) collected through `for_each_segment`, and the number of
+/// segments.
+template <typename Iterator>
+std::pair<std::vector<int>, size_t> collect_segments(Iterator first, Iterator last) {
+  std::vector<int> elements;
+  size_t segments = 0;
+  for_each_segment(first, last, [&](auto segment_first, auto segment_last) {
+    elements.insert(elements.end(), segment_first, segment_last);
+    ++segments;
+  });
+  return {elements, segments};
+}
+
+} // namespace
+
+static_assert(has_contiguous_segments<std::vector<int>::iterator>);
+static_assert(has_contiguous_segments<const char*>);
+static_assert(!has_contiguous_segments<std::list<int>::iterator>);
+#if defined(__GLIBCXX__)
+static_assert(has_contiguous_segments<std::deque<int>::iterator>);
+static_assert(has_contiguous_segments<std::deque<int>::const_iterator>);
+#endif
+
+TEST_PROPERTY(
+    "`for_each_segment` covers a deque subrange in order", [](const std::vector<int>& data) {
+      const std::deque<int> d(data.begin(), data.end());
+      const size_t from = *rc::gen::inRange<size_t>(0, d.size() + 1);
+      const size_t to = *rc::gen::inRange<size_t>(from, d.size() + 1);
+
+      const auto first = d.begin() + static_cast<ptrdiff_t>(from);
+      const auto last = d.begin() + static_cast<ptrdiff_t>(to);
+      RC_ASSERT(collect_segments(first, last).first == std::vector<int>(first, last));
+    }
+)
+
+TEST_CASE("`for_each_segment` passes the blocks of a deque") {
+  std::deque<int> d(10'000);
+  std::iota(d.begin(), d.end(), 0);
+
+  const auto [elements, segments] = collect_segments(d.begin() + 3, d.end() - 5);
+
+  CHECK(elements == std::vector<int>(d.begin() + 3, d.end() - 5));
+  if constexpr (has_contiguous_segments<std::deque<int>::iterator>)
+    CHECK(segments > 1);
+  else
+    CHECK(segments == 1);
+}
+
+TEST_CASE("`for_each_segment` passes a list as one segment") {
+  const std::list<int> l{1, 2, 3};
+  const auto [elements, segments] = collect_segments(l.begin(), l.end());
+  CHECK(elements == std::vector<int>{1, 2, 3});
+  CHECK(segments == 1);
+}
+
+TEST_CASE("`for_each_element` and `reduce_elements` visit the elements of a part in order") {
+  std::deque<int> d(5'000);
+  std::iota(d.begin(), d.end(), 0);
+  partitioning<std::deque<int>::iterator> p(d.begin(), d.end());
+  p.add_part_begin(0);
+  p.grow_by(0, 1'234);
+
+  std::vector<int> visited;
+  for_each_element(p, 1, [&](int x) { visited.push_back(x); });
+  CHECK(visited == std::vector<int>(d.begin() + 1'234, d.end()));
+
+  CHECK(reduce_elements(p, 0, 0L) == 1'233L * 1'234 / 2);
+  CHECK(reduce_elements(p, 1, 0L) == std::accumulate(d.begin() + 1'234, d.end(), 0L));
+}
+
+TEST_PROPERTY(
+    "`partition_part` splits a deque part by a predicate", [](const std::vector<int>& data) {
+      std::deque<int> d(data.begin(), data.end());
+      partitioning<std::deque<int>::iterator> p(d.begin(), d.end());
+      const auto is_even = [](int x) { return x % 2 == 0; };
+
+      partition_part(p, 0, is_even);
+
+      RC_ASSERT(p.parts_count() == size_t{2});
+      RC_ASSERT(std::all_of(p.part(0).first, p.part(0).second, is_even));
+      RC_ASSERT(std::none_of(p.part(1).first, p.part(1).second, is_even));
+      auto sorted_before = data;
+      std::ranges::sort(sorted_before);
+      auto sorted_after = std::vector<int>(d.begin(), d.end());
+      std::ranges::sort(sorted_after);
+      RC_ASSERT(sorted_after == sorted_before);
+    }
+)
+
+TEST_CASE("`partition_part` works on forward iterators") {
+  std::forward_list<int> l{1, 2, 3, 4, 5, 6};
+  partitioning<std::forward_list<int>::iterator> p(l.begin(), l.end());
+
+  partition_part(p, 0, [](int x) { return x > 3; });
+
+  REQUIRE(p.parts_count() == 2);
+  CHECK(p.part_size(0) == 3);
+  CHECK(std::all_of(p.part(0).first, p.part(0).second, [](int x) { return x > 3; }));
+  CHECK(std::none_of(p.part(1).first, p.part(1).second, [](int x) { return x > 3; }));
+}
@@ -0,0 +1,103 @@
+#include "positionless/streaming.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+using positionless::streaming_partitioning;
+
+/// Returns the newline-separated records read by `s`.
+static std::vector<std::string> read_records(streaming_partitioning& s) {
+  std::vector<std::string> r;
+  while (s.refill()) {
+    auto [begin, end] = s.records();
+    const char* record_begin = begin;
+    for (const char* c = begin; c != end; ++c) {
+      if (*c == '\n') {
+        r.emplace_back(record_begin, c);
+        record_begin = c + 1;
+      }
+    }
+    if (record_begin != end)
+      r.emplace_back(record_begin, end);
+  }
+  return r;
+}
+
+/// Returns the lines of `text`.
+static std::vector<std::string> lines_of(const std::string& text) {
+  std::vector<std::string> r;
+  std::istringstream in(text);
+  for (std::string line; std::getline(in, line);)
+    r.push_back(line);
+  return r;
+}
+
+TEST_PROPERTY(
+    "`streaming_partitioning` yields all the records of a stream",
+    [](std::vector<bool> line_ends) {
+      std::string text;
+      for (bool is_end : line_ends)
+        text.push_back(is_end ? '\n' : 'x');
+      size_t longest = 0;
+      size_t current = 0;
+      for (char c : text) {
+        current = c == '\n' ? 0 : current + 1;
+        longest = std::max(longest, current + 1);
+      }
+      const auto buffer_size = *rc::gen::inRange<size_t>(longest + 1, longest + 16);
+
+      std::istringstream in(text);
+      streaming_partitioning s(in, buffer_size);
+
+      RC_ASSERT(read_records(s) == lines_of(text));
+      RC_ASSERT(s.at_end());
+    }
+)
+
+TEST_PROPERTY(
+    "`streaming_partitioning` parts always cover the whole buffer",
+    [](std::vector<bool> line_ends) {
+      std::string text;
+      for (bool is_end : line_ends)
+        text.push_back(is_end ? '\n' : 'x');
+      text.push_back('\n');
+
+      std::istringstream in(text);
+      streaming_partitioning s(in, text.size());
+      while (s.refill()) {
+        RC_ASSERT(s.parts().parts_count() == size_t{3});
+        const auto records = s.parts().part(0);
+        RC_ASSERT(records.first != records.second);
+        RC_ASSERT(*std::prev(records.second) == '\n');
+        size_t sum = 0;
+        for (size_t i = 0; i < 3; ++i)
+          sum += s.parts().part_size(i);
+        RC_ASSERT(sum == text.size());
+      }
+    }
+)
+
+TEST_CASE("`streaming_partitioning` reads from file descriptors") {
+  int fds[2];
+  REQUIRE(::pipe(fds) == 0);
+  const std::string text = "alpha\nbeta\ngamma\ndelta";
+  REQUIRE(::write(fds[1], text.data(), text.size()) == static_cast<ssize_t>(text.size()));
+  ::close(fds[1]);
+
+  streaming_partitioning s(fds[0], 8);
+  CHECK(read_records(s) == std::vector<std::string>{"alpha", "beta", "gamma", "delta"});
+  ::close(fds[0]);
+}
+
+TEST_CASE("`streaming_partitioning` rejects records larger than the buffer") {
+  std::istringstream in("short\nthis record is too long\n");
+  streaming_partitioning s(in, 8);
+
+  CHECK(s.refill());
+  CHECK_THROWS_AS(s.refill(), std::length_error);
+}
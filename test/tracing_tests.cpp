@@ -0,0 +1,149 @@
+// Built as the separate `tracing_tests` executable, with `POSITIONLESS_TRACING` enabled.
+#include "positionless/algorithms.hpp"
+#include "positionless/partitioning.hpp"
+#include "positionless/tracing.hpp"
+
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using positionless::clear_trace;
+using positionless::collect_trace;
+using positionless::partitioning;
+using positionless::trace_event;
+using positionless::write_chrome_trace;
+
+static_assert(POSITIONLESS_TRACING);
+
+namespace {
+
+/// Returns the events of the calling thread named `name`.
+std::vector<trace_event> events_named(const char* name) {
+  std::vector<trace_event> r;
+  for (const auto& e : collect_trace()) {
+    if (std::strcmp(e.name, name) == 0)
+      r.push_back(e);
+  }
+  return r;
+}
+
+} // namespace
+
+TEST_CASE("partitioning operations record instant events with their arguments") {
+  clear_trace();
+  std::vector<int> data(10);
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.add_part_begin(0);
+  p.grow_by(0, 4);
+  p.remove_part(1);
+
+  const auto events = collect_trace();
+  REQUIRE(events.size() == 3);
+  CHECK(std::strcmp(events[0].name, "add_part_begin") == 0);
+  CHECK(std::strcmp(events[1].name, "grow_by") == 0);
+  CHECK(std::strcmp(events[1].arguments[0].name, "part") == 0);
+  CHECK(events[1].arguments[0].value == 0);
+  CHECK(std::strcmp(events[1].arguments[1].name, "n") == 0);
+  CHECK(events[1].arguments[1].value == 4);
+  CHECK(std::strcmp(events[2].name, "remove_part") == 0);
+  for (const auto& e : events)
+    CHECK_FALSE(e.complete);
+  CHECK(events[0].start_ns <= events[2].start_ns);
+}
+
+TEST_CASE("algorithms record their phases as complete events") {
+  clear_trace();
+  std::vector<int> data(1000);
+  for (size_t k = 0; k < data.size(); ++k)
+    data[k] = static_cast<int>((k * 7919) % 1000);
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+
+  positionless::sort_part(p, 0);
+
+  const auto sorts = events_named("sort_part");
+  const auto merges = events_named("merge_parts");
+  REQUIRE(sorts.size() == 1);
+  REQUIRE(merges.size() == 1);
+  CHECK(sorts[0].complete);
+  CHECK(sorts[0].start_ns <= merges[0].start_ns);
+  CHECK(merges[0].start_ns + merges[0].duration_ns <= sorts[0].start_ns + sorts[0].duration_ns);
+  CHECK(merges[0].arguments[1].value > 1);
+  CHECK(events_named("merge_with_next").size() == merges[0].arguments[1].value - 1);
+}
+
+TEST_CASE("each thread records events in its own buffer") {
+  clear_trace();
+  std::vector<int> data(10);
+  const auto work = [&] {
+    partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+    p.add_part_end(0);
+  };
+  std::thread t1(work);
+  t1.join();
+  std::thread t2(work);
+  t2.join();
+
+  const auto events = events_named("add_part_end");
+  REQUIRE(events.size() == 2);
+  CHECK(events[0].thread != events[1].thread);
+}
+
+TEST_CASE("the buffer of a thread keeps the latest events") {
+  clear_trace();
+  std::vector<int> data(10);
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.add_part_begin(0);
+  for (size_t k = 0; k < POSITIONLESS_TRACE_BUFFER_EVENTS; ++k) {
+    p.grow_by(0, 1);
+    p.transfer_to_next(0);
+  }
+
+  const auto events = collect_trace();
+  CHECK(events.size() == POSITIONLESS_TRACE_BUFFER_EVENTS);
+  CHECK(std::strcmp(events.back().name, "transfer_to_next") == 0);
+  CHECK(events_named("add_part_begin").empty());
+}
+
+TEST_CASE("traces are exported in the Chrome trace event format") {
+  clear_trace();
+  std::vector<int> data{3, 1, 2};
+  partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+  p.add_parts_end(0, 2);
+  positionless::sort_part(p, 0);
+
+  std::ostringstream os;
+  write_chrome_trace(os);
+  const std::string json = os.str();
+
+  CHECK(json.starts_with("{\"traceEvents\":["));
+  CHECK(json.ends_with("]}\n"));
+  CHECK(json.find("{\"name\":\"add_parts_end\",\"ph\":\"i\",") != std::string::npos);
+  CHECK(json.find("\"args\":{\"part\":0,\"count\":2}") != std::string::npos);
+  CHECK(json.find("{\"name\":\"sort_part\",\"ph\":\"X\",") != std::string::npos);
+  CHECK(json.find("\"dur\":") != std::string::npos);
+  CHECK(std::count(json.begin(), json.end(), '{') == std::count(json.begin(), json.end(), '}'));
+}
+
+TEST_CASE("the buffers of exited threads are recycled") {
+  clear_trace();
+  std::vector<int> data(10);
+  const auto work = [&] {
+    partitioning<std::vector<int>::iterator> p(data.begin(), data.end());
+    p.add_part_end(0);
+  };
+  std::thread(work).join();
+  const size_t buffers = positionless::detail::trace_buffers().buffers.size();
+
+  for (int k = 0; k < 100; ++k)
+    std::thread(work).join();
+
+  CHECK(positionless::detail::trace_buffers().buffers.size() == buffers);
+  const auto events = events_named("add_part_end");
+  REQUIRE(events.size() == 101);
+  for (size_t k = 1; k < events.size(); ++k)
+    CHECK(events[k - 1].thread < events[k].thread);
+}
@@ -0,0 +1,126 @@
+#include "positionless/translation.hpp"
+
+#include "detail/rapidcheck_wrapper.hpp"
+#include "detail/vector_partitioning.hpp"
+
+#include <algorithm>
+#include <forward_list>
+#include <list>
+#include <ranges>
+#include <vector>
+
+using positionless::part_range;
+using positionless::partitioning;
+using positionless::split_around;
+using positionless::split_at;
+using positionless::split_by;
+
+namespace {
+
+/// Returns `true` if `x` is even.
+bool is_even(int x) { return x % 2 == 0; }
+
+/// Returns the parts of `p`.
+template <typename Iterator>
+std::vector<std::pair<Iterator, Iterator>> parts_of(const partitioning<Iterator>& p) {
+  std::vector<std::pair<Iterator, Iterator>> r;
+  for (size_t i = 0; i < p.parts_count(); ++i)
+    r.push_back(p.part(i));
+  return r;
+}
+
+} // namespace
+
+TEST_PROPERTY(
+    "`split_by` with an iterator result splits the part in two at it",
+    [](vector_partitioning<int> vp) {
+      auto& p = vp.partitioning_;
+      const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count());
+      const auto before = parts_of(p);
+      const auto found = std::ranges::find_if(part_range(p, i), is_even);
+
+      split_by(p, i, std::ranges::find_if, is_even);
+
+      RC_ASSERT(p.parts_count() == before.size() + 1);
+      RC_ASSERT(p.part(i).first == before[i].first);
+      RC_ASSERT(p.part(i).second == found);
+      RC_ASSERT(p.part(i + 1).first == found);
+      RC_ASSERT(p.part(i + 1).second == before[i].second);
+      for (size_t j = 0; j < i; ++j)
+        RC_ASSERT(p.part(j) == before[j]);
+      for (size_t j = i + 1; j < before.size(); ++j)
+        RC_ASSERT(p.part(j + 1) == before[j]);
+    }
+)
+
+TEST_PROPERTY(
+    "`split_by` with a subrange result splits the part in three around it",
+    [](vector_partitioning<int> vp) {
+      auto& p = vp.partitioning_;
+      const size_t i = *rc::gen::inRange<size_t>(0, p.parts_count());
+      const auto before = parts_of(p);
+
+      split_by(p, i, std::ranges::partition, is_even);
+
+      RC_ASSERT(p.parts_count() == before.size() + 2);
+      RC_ASSERT(p.part(i).first == before[i].first);
+      RC_ASSERT(std::ranges::all_of(part_range(p, i), is_even));
+      RC_ASSERT(std::ranges::none_of(part_range(p, i + 1), is_even));
+      RC_ASSERT(p.is_part_empty(i + 2));
+      RC_ASSERT(p.part(i + 2).second == before[i].second);
+      for (size_t j = i + 1; j < before.size(); ++j)
+        RC_ASSERT(p.part(j + 2) == before[j]);
+    }
+)
+
+TEST_CASE("`split_by` accepts lambdas") {
+  std::vector<int> c{1, 2, 3, 4, 5, 6, 7};
+  partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+  const std::vector<int> needle{3, 4};
+
+  split_by(p, 0, [&](auto r) { return std::ranges::search(r, needle); });
+
+  REQUIRE(p.parts_count() == 3);
+  CHECK(std::ranges::equal(part_range(p, 0), std::vector{1, 2}));
+  CHECK(std::ranges::equal(part_range(p, 1), needle));
+  CHECK(std::ranges::equal(part_range(p, 2), std::vector{5, 6, 7}));
+}
+
+TEST_CASE("`split_by` leaves an empty part when nothing is found") {
+  std::vector<int> c{1, 3, 5};
+  partitioning<std::vector<int>::iterator> p(c.begin(), c.end());
+
+  split_by(p, 0, std::ranges::find_if, is_even);
+
+  REQUIRE(p.parts_count() == 2);
+  CHECK(p.part_size(0) == 3);
+  CHECK(p.is_part_empty(1));
+}
+
+TEST_CASE("`split_at` and `split_around` work on forward iterators") {
+  std::forward_list<int> c{1, 2, 3, 4, 5};
+  partitioning<std::forward_list<int>::iterator> p(c.begin(), c.end());
+
+  split_at(p, 0, std::next(c.begin(), 4));
+  REQUIRE(p.parts_count() == 2);
+  CHECK(std::ranges::equal(part_range(p, 0), std::vector{1, 2, 3, 4}));
+  CHECK(std::ranges::equal(part_range(p, 1), std::vector{5}));
+
+  split_around(p, 0, std::next(c.begin()), std::next(c.begin(), 3));
+  REQUIRE(p.parts_count() == 4);
+  CHECK(std::ranges::equal(part_range(p, 0), std::vector{1}));
+  CHECK(std::ranges::equal(part_range(p, 1), std::vector{2, 3}));
+  CHECK(std::ranges::equal(part_range(p, 2), std::vector{4}));
+  CHECK(std::ranges::equal(part_range(p, 3), std::vector{5}));
+}
+
+TEST_CASE("`split_by` works on bidirectional iterators") {
+  std::list<int> c{4, 1, 3, 2};
+  partitioning<std::list<int>::iterator> p(c.begin(), c.end());
+
+  split_by(p, 0, std::ranges::min_element);
+
+  REQUIRE(p.parts_count() == 2);
+  CHECK(std::ranges::equal(part_range(p, 0), std::vector{4}));
+  CHECK(std::ranges::equal(part_range(p, 1), std::vector{1, 3, 2}));
+}